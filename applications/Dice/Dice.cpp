@@ -28,10 +28,10 @@ void Dice::Loop() {
     KeyEventHandler(keyEvent.id, &keyEvent.info);
   }  // Handle them
 
-  if (!renderTimer.Tick(1000 / Device::fps))
+  if (!MatrixOS::LED::WaitForFrame())
   {
     return;
-  }  // Render at 100fps
+  }  // Render once per LED frame
 
   if (current_phase == Rolling)
   {
@@ -252,10 +252,7 @@ uint8_t Dice::GetRandomNumber(uint8_t upperbound, uint8_t lowerbound) {
 }
 
 void Dice::RenderDot(Point point, Color color) {
-  MatrixOS::LED::SetColor(point, color);
-  MatrixOS::LED::SetColor(point + Point(1, 0), color);
-  MatrixOS::LED::SetColor(point + Point(0, 1), color);
-  MatrixOS::LED::SetColor(point + Point(1, 1), color);
+  MatrixOS::LED::FillRect(point, Dimension(2, 2), color);
 }
 
 void Dice::RenderDots(uint8_t number, Color color) {
@@ -82,7 +82,6 @@ class Dice : public Application {
   Color ApplyColorEffect(Color color, UnderglowEffectMode effect, uint16_t period, uint16_t start_time);
   void UnderglowEffectModeAndSpeedMenu(DicePhase phase);
 
-  Timer renderTimer;
   uint32_t timestamp = 0;
   uint8_t rolled_number = 1;
   DicePhase current_phase = Rolling;
@@ -11,7 +11,7 @@ void Lighting::Loop()
   while (MatrixOS::KEYPAD::Get(&keyEvent))
   { KeyEventHandler(keyEvent.id, &keyEvent.info); }
 
-  if(renderTimer.Tick(1000/Device::fps))
+  if(MatrixOS::LED::WaitForFrame())
   {
     Update();
   }
@@ -55,7 +55,6 @@ class Lighting : public Application {
   CreateSavedVar("Lighting", animation, Animations, PoliceCar);
   CreateSavedVar("Lighting", animation_period, uint16_t, 1000);
 
-  Timer renderTimer;
   uint8_t base_layer;
   uint32_t start_time;
 };
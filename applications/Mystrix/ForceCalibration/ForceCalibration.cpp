@@ -58,6 +58,16 @@ void ForceCalibration::Setup() {
   keypadVisualizerBtn.OnPress([&]() -> void { ForceGridVisualizer(); });
   forceCalibrationMenu.AddUIComponent(keypadVisualizerBtn, Point(1, 3));
 
+  UIButton velocityCurveBtn;
+  velocityCurveBtn.SetName("Velocity Curve");
+  velocityCurveBtn.SetColorFunc([&]() -> Color {
+    const Color curveColors[] = {Color(0xFFFFFF), Color(0x00FF00), Color(0xFF8000), Color(0xFF00FF)};
+    return curveColors[Device::KeyPad::FSR::GetVelocityCurve() & 3];
+  });
+  velocityCurveBtn.SetSize(Dimension(1, 2));
+  velocityCurveBtn.OnPress([&]() -> void { NextVelocityCurve(); });
+  forceCalibrationMenu.AddUIComponent(velocityCurveBtn, Point(7, 3));
+
   forceCalibrationMenu.Start();
   Exit();
 }
@@ -74,6 +84,13 @@ void ForceCalibration::ClearHighCalibration()
   Device::KeyPad::FSR::ClearHighCalibration();
 }
 
+// Linear -> Log -> Exp, custom curves are set through SetCustomVelocityCurve()
+void ForceCalibration::NextVelocityCurve()
+{
+  EVelocityCurve shape = Device::KeyPad::FSR::GetVelocityCurve();
+  Device::KeyPad::FSR::SetVelocityCurve(shape >= VELOCITY_CURVE_EXP ? VELOCITY_CURVE_LINEAR : (EVelocityCurve)(shape + 1));
+}
+
 void ForceCalibration::SetOffset(CalibrationType type)
 {
   int16_t offset;
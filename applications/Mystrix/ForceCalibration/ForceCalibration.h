@@ -17,6 +17,9 @@ namespace Device::KeyPad::FSR
   int16_t GetHighOffset();
   void SetLowOffset(int16_t offset);
   void SetHighOffset(int16_t offset);
+  EVelocityCurve GetVelocityCurve();
+  void SetVelocityCurve(EVelocityCurve shape);
+  void SetCustomVelocityCurve(const VelocityCurvePoint* points, uint8_t count);
   uint16_t GetRawReading(uint8_t x, uint8_t y);
   uint32_t GetScanCount();
 }
@@ -37,6 +40,7 @@ class ForceCalibration : public Application {
   void ClearHighCalibration();
 
   void SetOffset(CalibrationType type);
+  void NextVelocityCurve();
 
   void ForceGridVisualizer();
 
@@ -5,6 +5,35 @@
 
 #include "applications/BrightnessControl/BrightnessControl.h"
 
+// Convert configs saved in the old Color layout and save them back
+void Note::LoadLegacyConfigs() {
+  vector<char> data = MatrixOS::NVS::GetVariable(NOTE_CONFIGS_HASH);
+  LegacyNoteLayoutConfig legacyConfigs[2];
+  if (data.size() != sizeof(legacyConfigs))
+  {
+    MLOGW("Note", "Saved layout configs have an unknown layout, using defaults");
+    return;
+  }
+  memcpy((void*)legacyConfigs, data.data(), sizeof(legacyConfigs));
+
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    LegacyNoteLayoutConfig& legacy = legacyConfigs[i];
+    NoteLayoutConfig& config = notePadConfigs[i];
+    config.rootKey = legacy.rootKey;
+    config.enforceScale = legacy.enforceScale;
+    config.alignRoot = legacy.alignRoot;
+    config.scale = legacy.scale;
+    config.octave = legacy.octave;
+    config.channel = legacy.channel;
+    config.overlap = legacy.overlap;
+    config.velocitySensitive = legacy.velocitySensitive;
+    config.color = Color::FromLegacy(legacy.color);
+    config.rootColor = Color::FromLegacy(legacy.rootColor);
+  }
+  MatrixOS::NVS::SetVariable(NOTE_CONFIGS_HASH, notePadConfigs, sizeof(notePadConfigs));
+}
+
 void Note::Setup() {
   // Set up / Load configs --------------------------------------------------------------------------
 
@@ -15,7 +44,8 @@ void Note::Setup() {
   // Load From NVS
   if (nvsVersion == (uint32_t)NOTE_APP_VERSION)
   { 
-    MatrixOS::NVS::GetVariable(NOTE_CONFIGS_HASH, notePadConfigs, sizeof(notePadConfigs)); 
+    if (MatrixOS::NVS::GetVariable(NOTE_CONFIGS_HASH, notePadConfigs, sizeof(notePadConfigs)) == 2)
+    { LoadLegacyConfigs(); }
   }
   else
   { 
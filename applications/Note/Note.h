@@ -21,6 +21,7 @@ class Note : public Application {
   CreateSavedVar("Note", splitView, ESpiltView, SINGLE_VIEW);
 
   void Setup() override;
+  void LoadLegacyConfigs();
 
   void KeyEventHandler(uint16_t keyID, KeyInfo* keyInfo);
 
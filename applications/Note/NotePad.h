@@ -18,6 +18,20 @@ struct NoteLayoutConfig {
   Color rootColor = Color(0x0040FF);
 };
 
+// NoteLayoutConfig as saved before Color became a plain value
+struct LegacyNoteLayoutConfig {
+  uint8_t rootKey;
+  bool enforceScale;
+  bool alignRoot;
+  uint16_t scale;
+  int8_t octave;
+  uint8_t channel;
+  uint8_t overlap;
+  bool velocitySensitive;
+  Color::Legacy color;
+  Color::Legacy rootColor;
+};
+
 class NotePad : public UIComponent {
  public:
   Dimension dimension;
@@ -8,11 +8,7 @@ void Performance::Setup() {
   MatrixOS::NVS::GetVariable(custom_palette_available_nvs_hash, custom_palette_available, sizeof(custom_palette_available));
   for (uint8_t i = 0; i < CUSTOM_PALETTE_COUNT; i++)
   {
-    if (custom_palette_available[i])
-    {
-      MatrixOS::NVS::GetVariable(custom_palette_nvs_hash[i], custom_palette[i], sizeof(custom_palette[i]));
-    }
-    else
+    if (!custom_palette_available[i] || !LoadCustomPalette(i))
     {
       custom_palette[i][0] = Color(0);
       for (uint8_t j = 1; j < 128; j++)
@@ -23,6 +19,25 @@ void Performance::Setup() {
   }
 }
 
+bool Performance::LoadCustomPalette(uint8_t custom_palette_id) {
+  int8_t result = MatrixOS::NVS::GetVariable(custom_palette_nvs_hash[custom_palette_id], custom_palette[custom_palette_id], sizeof(custom_palette[custom_palette_id]));
+  if (result == 0)
+  { return true; }
+  if (result != 2)
+  { return false; }
+
+  // Palette saved before Color became a plain 4 byte value, convert it and save it back in the current layout
+  vector<char> data = MatrixOS::NVS::GetVariable(custom_palette_nvs_hash[custom_palette_id]);
+  if (!Color::FromLegacy(data.data(), data.size(), custom_palette[custom_palette_id], 128))
+  {
+    MLOGW("Performance", "Custom Palette %d has an unknown layout", custom_palette_id);
+    return false;
+  }
+  MatrixOS::NVS::SetVariable(custom_palette_nvs_hash[custom_palette_id], custom_palette[custom_palette_id], sizeof(custom_palette[custom_palette_id]));
+  MLOGI("Performance", "Custom Palette %d migrated", custom_palette_id);
+  return true;
+}
+
 void Performance::Loop() {
   if (stfu && stfuTimer.Tick(1000 / Device::fps))
   {
@@ -241,18 +256,36 @@ void Performance::SysExHandler(MidiPacket midiPacket) {
 
         // MLOGD("Performance", "Color: #%.2X%.2X%.2X, NN count: %d", color.R, color.G, color.B, n_count);
 
+        // Grid points sharing this color are collected and written as one batch. The batch is flushed before any fill
+        // so the write order stays the same
+        Point gridPoints[64];
+        uint8_t gridCount = 0;
+
         // Goes through all N
-        for (uint16_t n = 0; n < n_count; n++)
+        for (uint16_t n = 0; n < n_count && ptr < sysExBuffer.size(); n++)
         {
-          if (sysExBuffer[ptr] == 0)  // Global full
+          if (sysExBuffer[ptr] > 0 && sysExBuffer[ptr] < 99)  // Grid
           {
-            MatrixOS::LED::Fill(color, targetLayer);
+            gridPoints[gridCount++] = Point(sysExBuffer[ptr] % 10 - 1, 8 - (sysExBuffer[ptr] / 10));
+            // MLOGD("Performance", "Grid %d %d", xy.x, xy.y);
+            if (gridCount == 64)
+            {
+              MatrixOS::LED::SetColors(gridPoints, gridCount, color, targetLayer);
+              gridCount = 0;
+            }
+            ptr++;
+            continue;
           }
-          else if (sysExBuffer[ptr] < 99)  // Grid
+
+          if (gridCount)
           {
-            Point xy = Point(sysExBuffer[ptr] % 10 - 1, 8 - (sysExBuffer[ptr] / 10));
-            // MLOGD("Performance", "Grid %d %d", xy.x, xy.y);
-            MatrixOS::LED::SetColor(xy, color, targetLayer);
+            MatrixOS::LED::SetColors(gridPoints, gridCount, color, targetLayer);
+            gridCount = 0;
+          }
+
+          if (sysExBuffer[ptr] == 0)  // Global full
+          {
+            MatrixOS::LED::Fill(color, targetLayer);
           }
           else if (sysExBuffer[ptr] == 99)  // Mode Light
           {
@@ -261,21 +294,18 @@ void Performance::SysExHandler(MidiPacket midiPacket) {
           else if (sysExBuffer[ptr] < 110)  // Row Fill
           {
             int8_t row = 108 - sysExBuffer[ptr];
-            for (int8_t x = 0; x < 10; x++)
-            {
-              MatrixOS::LED::SetColor(Point(x, row), color, targetLayer);
-            }
+            MatrixOS::LED::FillRect(Point(0, row), Dimension(10, 1), color, targetLayer);
           }
           else if (sysExBuffer[ptr] < 120)  // Column Fill
           {
             int8_t column = sysExBuffer[ptr] - 111;
-            for (int8_t y = 0; y < 10; y++)
-            {
-              MatrixOS::LED::SetColor(Point(column, y), color, targetLayer);
-            }
+            MatrixOS::LED::FillRect(Point(column, 0), Dimension(1, 10), color, targetLayer);
           }
           ptr++;  // Since ptr is the pointer of in vector, we need to read the next NN, inc the ptr by 1
         }
+
+        if (gridCount)
+        { MatrixOS::LED::SetColors(gridPoints, gridCount, color, targetLayer); }
       }
       break;
     }
@@ -289,6 +319,11 @@ void Performance::SysExHandler(MidiPacket midiPacket) {
 
       uint8_t targetLayer = uiOpened ? canvasLedLayer : 0;
 
+      // Consecutive grid writes are collected and written as one batch, flushed before any fill so the write order stays the same
+      Point gridPoints[64];
+      Color gridColors[64];
+      uint8_t gridCount = 0;
+
       uint16_t ptr = 1;  // Index 0 is the command 0x5f, we start ptr at 1
       while (ptr < sysExBuffer.size())
       {
@@ -310,14 +345,28 @@ void Performance::SysExHandler(MidiPacket midiPacket) {
 
         // MLOGD("Performance", "Color: #%.2X%.2X%.2X, NN count: %d", color.R, color.G, color.B, n_count);
 
-        if (index == 0)  // Global full
+        if (index > 0 && index < 99)  // Grid
         {
-          MatrixOS::LED::Fill(color, targetLayer);
+          gridPoints[gridCount] = Point(index % 10 - 1, 8 - (index / 10));
+          gridColors[gridCount] = color;
+          gridCount++;
+          if (gridCount == 64)
+          {
+            MatrixOS::LED::SetColors(gridPoints, gridColors, gridCount, targetLayer);
+            gridCount = 0;
+          }
+          continue;
         }
-        else if (index < 99)  // Grid
+
+        if (gridCount)
         {
-          Point xy = Point(index % 10 - 1, 8 - (index / 10));
-          MatrixOS::LED::SetColor(xy, color, targetLayer);
+          MatrixOS::LED::SetColors(gridPoints, gridColors, gridCount, targetLayer);
+          gridCount = 0;
+        }
+
+        if (index == 0)  // Global full
+        {
+          MatrixOS::LED::Fill(color, targetLayer);
         }
         else if (index == 99)  // Mode Light
         {
@@ -326,20 +375,17 @@ void Performance::SysExHandler(MidiPacket midiPacket) {
         else if (index < 110)  // Row Fill
         {
           int8_t row = 108 - index;
-          for (int8_t x = 0; x < 10; x++)
-          {
-            MatrixOS::LED::SetColor(Point(x, row), color, targetLayer);
-          }
+          MatrixOS::LED::FillRect(Point(0, row), Dimension(10, 1), color, targetLayer);
         }
         else if (index < 120)  // Column Fill
         {
           int8_t column = index - 111;
-          for (int8_t y = 0; y < 10; y++)
-          {
-            MatrixOS::LED::SetColor(Point(column, y), color, targetLayer);
-          }
+          MatrixOS::LED::FillRect(Point(column, 0), Dimension(1, 10), color, targetLayer);
         }
       }
+
+      if (gridCount)
+      { MatrixOS::LED::SetColors(gridPoints, gridColors, gridCount, targetLayer); }
       break;
     }
     case 0x41:  // Retina Custom Palette
@@ -55,6 +55,7 @@ class Performance : public Application {
 
   void ActionMenu();
   void PaletteViewer(uint8_t custom_palette_id);
+  bool LoadCustomPalette(uint8_t custom_palette_id);
 
   void stfuScan();
 
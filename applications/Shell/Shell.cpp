@@ -19,6 +19,56 @@ void Shell::Setup()
     MLOGD("Shell", "Matrix OS Largest Free Block: %.2fkb", info.largest_free_block / 1024.0f);
     MLOGD("Shell", "Matrix OS Total Blocks: %d", info.total_blocks);
   #endif
+  LogLEDStats();
+  LogKeyPadStats();
+}
+
+// Shell comes back every time an app exits, so this covers the app that just ran. Goes out over USB CDC as well when
+// logging to it is enabled.
+void Shell::LogLEDStats() {
+  MatrixOS::LED::BufferPoolStats ledBufferPool = MatrixOS::LED::GetBufferPoolStats();
+  MLOGD("Shell", "LED Buffer Pool: %d/%d used, peak %d, %d allocations", ledBufferPool.used, ledBufferPool.size, ledBufferPool.peak, ledBufferPool.allocations);
+
+  MatrixOS::LED::FrameStats frame = MatrixOS::LED::GetFrameStats();
+  MLOGD("Shell", "LED Frames: %d ticks, %d/%d presented/requested, %d dropped, %d late, %d SetColor/s", frame.frames, frame.presented, frame.requested, frame.dropped, frame.late, frame.set_color_per_second);
+  const char* timingNames[] = {"Crossfade", "Output", "Lock Wait"};
+  MatrixOS::LED::FrameTiming* timings[] = {&frame.crossfade, &frame.output, &frame.lock_wait};
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    if (timings[i]->count == 0)
+    { continue; }
+    MLOGD("Shell", "LED %s: avg %dus, max %dus over %d frames", timingNames[i], timings[i]->total_us / timings[i]->count, timings[i]->max_us, timings[i]->count);
+  }
+  MatrixOS::LED::ResetFrameStats();
+}
+
+void Shell::LogKeyPadStats() {
+  MatrixOS::KEYPAD::KeyEventStats keyevent = MatrixOS::KEYPAD::GetKeyEventStats();
+  MLOGD("Shell", "KeyEvents: %d, %d dropped, %d releases dropped, %d aftertouch/hold coalesced, peak %d/%d queued", keyevent.events, keyevent.dropped, keyevent.dropped_releases, keyevent.coalesced, keyevent.peak, KEYEVENT_QUEUE_SIZE);
+  MatrixOS::KEYPAD::ResetKeyEventStats();
+
+  Device::KeyPad::ScanStats scan = Device::KeyPad::GetScanStats();
+  MLOGD("Shell", "KeyPad Scans: %d idle / %d active / %d hold, %dms / %dms / %dms, %d rate switches", scan.scans[0], scan.scans[1], scan.scans[2], scan.time_ms[0], scan.time_ms[1], scan.time_ms[2], scan.switches);
+  Device::KeyPad::ResetScanStats();
+
+  Device::KeyPad::AftertouchStats aftertouch = Device::KeyPad::GetAftertouchStats();
+  MLOGD("Shell", "Aftertouch: %d held back, %d flushed before release", aftertouch.suppressed, aftertouch.flushed);
+  Device::KeyPad::ResetAftertouchStats();
+
+#ifdef MATRIXOS_LATENCY_TRACE
+  const char* stageNames[] = {"Queue", "Dequeue", "MIDI Send", "USB TX", "BLE TX", "UART TX"};
+  for (uint8_t stage = 0; stage < MatrixOS::SYS::TRACE_STAGE_COUNT; stage++)
+  {
+    MatrixOS::SYS::LatencyHistogram histogram = MatrixOS::SYS::GetLatencyHistogram((MatrixOS::SYS::ETraceStage)stage);
+    if (histogram.count == 0)
+    { continue; }
+    string buckets;
+    for (uint8_t i = 0; i < LATENCY_BUCKETS; i++)
+    { buckets += " " + std::to_string(histogram.buckets[i]); }
+    MLOGD("Shell", "Key to %s: avg %dus, max %dus over %d, log2 us buckets:%s", stageNames[stage], histogram.total_us / histogram.count, histogram.max_us, histogram.count, buckets.c_str());
+  }
+  MatrixOS::SYS::ResetLatencyHistograms();
+#endif
 }
 
 void Shell::Loop() {
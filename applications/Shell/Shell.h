@@ -19,6 +19,8 @@ class Shell : public Application {
   void ApplicationLauncher();
   void HiddenApplicationLauncher();
   void LaunchAnimation(Point origin, Color color);
+  void LogLEDStats();
+  void LogKeyPadStats();
 };
 
 inline Application_Info Shell::info = {
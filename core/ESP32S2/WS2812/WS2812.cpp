@@ -20,6 +20,18 @@ namespace WS2812
   static rmt_item32_t bit1;
   static rmt_item32_t reset;
 
+  // value -> scale8_video(value, brightness), rebuilt only when the brightness changes
+  static uint8_t output_lut[256];
+  static int16_t output_lut_brightness = -1;
+
+  static void UpdateOutputLUT(uint8_t brightness) {
+    if (output_lut_brightness == brightness)
+      return;
+    for (uint16_t value = 0; value < 256; value++)
+      output_lut[value] = Color::scale8_video(value, brightness);
+    output_lut_brightness = brightness;
+  }
+
   void Init(rmt_channel_t rmt_channel, gpio_num_t gpio_tx, uint16_t numsOfLED) {
     rmt_config_t config = RMT_DEFAULT_CONFIG_TX(gpio_tx, rmt_channel);
     // set counter clock to 40MHz
@@ -82,11 +94,12 @@ namespace WS2812
   }
 
   void setup_rmt_data_buffer(Color* array, uint8_t brightness) {
+    UpdateOutputLUT(brightness);
     // rmtBuffer[0] = reset;
     for (uint16_t led = 0; led < numsOfLED; led++)
     {
       // ESP_LOGV("RMT", "LED %d", led);
-      uint32_t bits_to_send = array[led].GRB(brightness);
+      uint32_t bits_to_send = (output_lut[array[led].G] << 16) | (output_lut[array[led].R] << 8) | output_lut[array[led].B];
       uint32_t mask = 1 << (BITS_PER_LED_CMD - 1);
       for (uint32_t bit = 0; bit < BITS_PER_LED_CMD; bit++)
       {
@@ -11,8 +11,54 @@ namespace WS2812
 
   std::vector<LEDPartition>* led_partitions;
 
-  uint8_t* dither_error;
+  uint16_t* dither_error; // Per channel sigma delta accumulator, 16 bit fraction
   uint8_t* led_data;
+  uint32_t dithering_partitions = 0; // Partitions whose last output carries a fraction, re-encoded every frame
+
+  // Output table for each partition. The low byte is the channel value after gamma and scale8_video by the partition
+  // brightness, same as the other device families, the high byte is the fraction scale8_video drops, left for
+  // dithering. Rebuilt only when the brightness changes.
+  struct PartitionLUT {
+    bool valid = false;
+    bool gamma = false;
+    uint8_t brightness = 0;
+    uint16_t table[256];
+  };
+  PartitionLUT* partition_luts;
+
+  void UpdatePartitionLUT(PartitionLUT& lut, uint8_t brightness) {
+    if (lut.valid && lut.brightness == brightness && lut.gamma == gamma_correction)
+    { return; }
+
+    for (uint16_t value = 0; value < 256; value++)
+    {
+      uint8_t input = gamma_correction ? led_gamma[value] : value;
+      uint8_t output = Color::scale8_video(input, brightness);
+      uint8_t fraction = output == 255 ? 0 : (input * brightness) & 0xFF; // Full output has no step left to dither to
+      lut.table[value] = output | (fraction << 8);
+    }
+    lut.brightness = brightness;
+    lut.gamma = gamma_correction;
+    lut.valid = true;
+  }
+
+  // First order sigma delta, the fraction is carried over frames so the average output matches the 16 bit value.
+  // Values under dithering_threshold would visibly flicker, they are rounded instead. Return true if the channel is
+  // dithering.
+  inline bool Dither(uint8_t& output, uint16_t& error, uint16_t fraction) {
+    if (fraction == 0)
+    { return false; }
+    if (output < dithering_threshold)
+    {
+      output += fraction >> 15;
+      return false;
+    }
+    uint32_t sum = error + fraction;
+    if (sum > UINT16_MAX)
+    { output += 1; }
+    error = sum;
+    return true;
+  }
 
   typedef struct {
     rmt_encoder_t base;
@@ -125,11 +171,12 @@ namespace WS2812
     }
 
     led_data = (uint8_t*)malloc(numsOfLED * 3);
+    partition_luts = new PartitionLUT[led_partitions.size()];
 
-    dither_error = (uint8_t*)malloc(numsOfLED * 3 * sizeof(uint8_t));
+    dither_error = (uint16_t*)malloc(numsOfLED * 3 * sizeof(uint16_t));
     for (uint16_t i = 0; i < numsOfLED * 3; i++)
     {
-      dither_error[i] = esp_random() & 0x7F; // Limit the random error to 8 bits
+      dither_error[i] = esp_random(); // Random start phase so neighbouring LEDs don't step together
     }
 
     rmt_tx_channel_config_t rmt_channel_config = {
@@ -149,83 +196,125 @@ namespace WS2812
     ESP_ERROR_CHECK(rmt_enable(rmt_channel));
   }
 
-  IRAM_ATTR void Show(Color* buffer, std::vector<uint8_t>& brightness) {
-    // rmt_tx_wait_all_done(rmt_channel, portMAX_DELAY);
-    // TODO: IF rmt is busy, just skip
+  void Transmit(uint32_t dirty_partitions) {
+    uint16_t end = 0;
+    for (uint8_t partition_index = 0; partition_index < WS2812::led_partitions->size(); partition_index++)
+    {
+      LEDPartition& local_partition = WS2812::led_partitions->at(partition_index);
+      if ((dirty_partitions & (1UL << partition_index)) && local_partition.start + local_partition.size > end)
+      { end = local_partition.start + local_partition.size; }
+    }
+    rmt_transmit(rmt_channel, rmt_encoder, led_data, end * 3, &rmt_config);
+  }
+
+  // led_data is transmitted straight from memory, so it can't be touched until the last frame is out
+  bool Busy() {
+    return rmt_tx_wait_all_done(rmt_channel, 0) != ESP_OK;
+  }
+
+  // Partitions not flagged in dirty_partitions keep their last encoded data in led_data, so their scale and dither pass
+  // is skipped, unless they are dithering. The LEDs are daisy chained, so the strip is transmitted up to the end of the
+  // last dirty partition, the LEDs past it hold what they latched last time.
+  IRAM_ATTR bool Show(Color* buffer, std::vector<uint8_t>& brightness, uint32_t dirty_partitions) {
+    if (dithering)
+    { dirty_partitions |= dithering_partitions; }
+
+    if (dirty_partitions == 0)
+    { return true; }
+
+    if (Busy())
+    { return false; }
     
     for (uint8_t partition_index = 0; partition_index < WS2812::led_partitions->size(); partition_index++)
     {
-      LEDPartition local_partition = WS2812::led_partitions->at(partition_index);
+      if ((dirty_partitions & (1UL << partition_index)) == 0)
+      { continue; }
+
+      LEDPartition& local_partition = WS2812::led_partitions->at(partition_index);
+      dithering_partitions &= ~(1UL << partition_index);
 
       if (brightness[partition_index] == 0 || partition_index >= brightness.size()) {
         memset(led_data + local_partition.start * 3, 0, local_partition.size * 3);
         continue;
       }
 
-      uint8_t local_brightness = brightness[partition_index];
+      PartitionLUT& lut = partition_luts[partition_index];
+      UpdatePartitionLUT(lut, brightness[partition_index]);
 
-      for (uint16_t i = 0; i < WS2812::led_partitions->at(partition_index).size; i++)
+      bool partition_dithering = false;
+      for (uint16_t i = 0; i < local_partition.size; i++)
       {
         uint16_t buffer_index = local_partition.start + i;
         uint16_t data_index_g = buffer_index * 3;
         uint16_t data_index_r = data_index_g + 1;
         uint16_t data_index_b = data_index_g + 2;
 
-        led_data[data_index_g] = Color::scale8_video(buffer[buffer_index].G, local_brightness);
-        led_data[data_index_r] = Color::scale8_video(buffer[buffer_index].R, local_brightness);
-        led_data[data_index_b] = Color::scale8_video(buffer[buffer_index].B, local_brightness);
+        uint16_t output_g = lut.table[buffer[buffer_index].G];
+        uint16_t output_r = lut.table[buffer[buffer_index].R];
+        uint16_t output_b = lut.table[buffer[buffer_index].B];
+
+        led_data[data_index_g] = output_g;
+        led_data[data_index_r] = output_r;
+        led_data[data_index_b] = output_b;
 
         if(dithering == false) {
           continue;
         }
 
-        const uint8_t dither_error_threshold = 16;
+        partition_dithering |= Dither(led_data[data_index_g], dither_error[data_index_g], output_g & 0xFF00);
+        partition_dithering |= Dither(led_data[data_index_r], dither_error[data_index_r], output_r & 0xFF00);
+        partition_dithering |= Dither(led_data[data_index_b], dither_error[data_index_b], output_b & 0xFF00);
+      }
 
-        if(led_data[data_index_g] >= dithering_threshold)
-        {
-          uint8_t new_dither_error_g = (buffer[buffer_index].G * local_brightness) - (led_data[data_index_g] << 8);
-          if (new_dither_error_g >= dither_error_threshold)
-          {
-            dither_error[data_index_g] += new_dither_error_g >> 1;
-            if (dither_error[data_index_g] >= 128)
-            {
-              led_data[data_index_g] += 1;
-              dither_error[data_index_g] -= 128;
-            }
-          }
-        }
+      if (partition_dithering)
+      { dithering_partitions |= 1UL << partition_index; }
+    }
 
-        if(led_data[data_index_r] >= dithering_threshold)
-        {
-          uint8_t new_dither_error_r = (buffer[buffer_index].R * local_brightness) - (led_data[data_index_r] << 8);
-          if (new_dither_error_r >= dither_error_threshold)
-          {
-            dither_error[data_index_r] += new_dither_error_r >> 1;
-            if (dither_error[data_index_r] >= 128)
-            {
-              led_data[data_index_r] += 1;
-              dither_error[data_index_r] -= 128;
-            }
-          }
-        }
+    Transmit(dirty_partitions);
+    return true;
+  }
+
+  // 16 bit input keeps the full precision of crossfades through the brightness scaling, the fraction goes to dithering
+  IRAM_ATTR bool Show(Color16* buffer, std::vector<uint8_t>& brightness, uint32_t dirty_partitions) {
+    if (dirty_partitions == 0)
+    { return true; }
+
+    if (Busy())
+    { return false; }
+
+    for (uint8_t partition_index = 0; partition_index < WS2812::led_partitions->size(); partition_index++)
+    {
+      if ((dirty_partitions & (1UL << partition_index)) == 0)
+      { continue; }
+
+      LEDPartition& local_partition = WS2812::led_partitions->at(partition_index);
 
-        if(led_data[data_index_b] >= dithering_threshold)
+      if (brightness[partition_index] == 0 || partition_index >= brightness.size()) {
+        memset(led_data + local_partition.start * 3, 0, local_partition.size * 3);
+        continue;
+      }
+
+      uint8_t local_brightness = brightness[partition_index];
+
+      for (uint16_t i = 0; i < local_partition.size; i++)
+      {
+        uint16_t buffer_index = local_partition.start + i;
+        uint16_t data_index = buffer_index * 3;
+        uint16_t channels[3] = {buffer[buffer_index].G, buffer[buffer_index].R, buffer[buffer_index].B};
+
+        for (uint8_t channel = 0; channel < 3; channel++)
         {
-          uint8_t new_dither_error_b = (buffer[buffer_index].B * local_brightness) - (led_data[data_index_b] << 8);
-          if (new_dither_error_b >= dither_error_threshold)
-          {
-            dither_error[data_index_b] += new_dither_error_b >> 1;
-            if (dither_error[data_index_r] >= 128)
-            {
-              led_data[data_index_r] += 1;
-              dither_error[data_index_r] -= 128;
-            }
-          }
+          uint32_t scaled = channels[channel] * local_brightness;
+          uint8_t output = (scaled >> 16) + (channels[channel] > 0xFF);  // scale8_video of the high byte
+          uint16_t fraction = output == 255 ? 0 : scaled & 0xFFFF;
+          if (dithering)
+          { Dither(output, dither_error[data_index + channel], fraction); }
+          led_data[data_index + channel] = output;
         }
-
       }
     }
 
-    rmt_transmit(rmt_channel, rmt_encoder, led_data, numsOfLED * 3, &rmt_config);
+    Transmit(dirty_partitions);
+    return true;
   }
 }
\ No newline at end of file
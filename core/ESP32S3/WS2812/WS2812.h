@@ -6,6 +6,7 @@
 #include "driver/rmt_tx.h"
 #include "driver/rmt_encoder.h"
 #include "framework/Color.h"
+#include "framework/Color16.h"
 #include "framework/LEDPartition.h"
 #include "esp_check.h"
 #include "esp_attr.h"
@@ -39,6 +40,10 @@ namespace WS2812
 {
   inline bool dithering = true;
   inline uint8_t dithering_threshold = 4; // Channel value lower than this will not dither
+  inline bool gamma_correction = false; // Apply led_gamma in the output stage
   void Init(gpio_num_t gpio_pin, std::vector<LEDPartition>& led_partitions);
-  IRAM_ATTR void Show(Color* buffer, std::vector<uint8_t>& brightness);
+  bool Busy();
+  // Return false without touching the output if the last frame is still being transmitted
+  IRAM_ATTR bool Show(Color* buffer, std::vector<uint8_t>& brightness, uint32_t dirty_partitions = UINT32_MAX);
+  IRAM_ATTR bool Show(Color16* buffer, std::vector<uint8_t>& brightness, uint32_t dirty_partitions = UINT32_MAX);
 }
\ No newline at end of file
@@ -17,6 +17,18 @@ namespace WS2812
   uint16_t bufferSize;
   int32_t progress = -1;  //# of led sent, -1 means signal end has been send and ready for new job
 
+  // value -> scale8_video(value, brightness), rebuilt only when the brightness changes
+  static uint8_t output_lut[256];
+  static int16_t output_lut_brightness = -1;
+
+  static void UpdateOutputLUT(uint8_t brightness) {
+    if (output_lut_brightness == brightness)
+      return;
+    for (uint16_t value = 0; value < 256; value++)
+      output_lut[value] = Color::scale8_video(value, brightness);
+    output_lut_brightness = brightness;
+  }
+
   void Init(TIM_HandleTypeDef* htim, unsigned int TIM_Channel, uint16_t NumsOfLED) {
 
     // Timer Setup
@@ -56,6 +68,7 @@ namespace WS2812
     progress = 0;
     // HAL_TIM_PWM_Stop_DMA(htim, tim_Channel);
     frameBuffer = array;
+    UpdateOutputLUT(brightness);
     PrepLEDBuffer(brightness);
     SendData();
     return 1;
@@ -80,7 +93,7 @@ namespace WS2812
     }
     while (index <= (bufferSize - 24) && progress < numsOfLED)
     {  // Fills pwm until buffer is full or all LED completely processed
-      uint32_t GRB = frameBuffer[progress].GRB(brightness);
+      uint32_t GRB = (output_lut[frameBuffer[progress].G] << 16) | (output_lut[frameBuffer[progress].R] << 8) | output_lut[frameBuffer[progress].B];
       for (int8_t i = 23; i >= 0; i--)
       {
         pwmBuffer[index] = GRB & (1 << i) ? TH_DutyCycle : TL_DutyCycle;
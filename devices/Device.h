@@ -27,9 +27,17 @@ namespace Device
 
   string GetSerial();
 
+  uint32_t Micros();  // Free running microsecond counter, wraps around. For profiling
+
   namespace LED
   {
-    void Update(Color* frameBuffer, vector<uint8_t>& brightness);  // Render LED
+    bool Update(Color* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions);  // Render LED
+                                        // dirtyPartitions is a bitmap of the led_partitions that changed (pixel or
+                                        // brightness) since the last Update. Clean partitions can keep their last output
+                                        // Called every frame, with 0 when nothing changed so temporal dithering can run
+                                        // Return false if the transport is still busy and nothing was sent
+    bool Update(Color16* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions);  // 16 bit per channel
+                                        // frame (crossfades), then the next 8 bit frame is sent in full
     uint16_t XY2Index(Point xy);        // Grid XY to global buffer index, return UINT16_MAX if not index for given XY
     uint16_t ID2Index(uint16_t ledID);  // Local led Index to buffer index, return UINT16_MAX if not index for given
                                         // Index
@@ -47,6 +55,26 @@ namespace Device
                                // ID is assigned to given XY
     Point ID2XY(uint16_t keyID);  // Locate XY for given key ID, return Point(INT16_MIN, INT16_MIN) if no XY found for
                                   // given ID;
+
+    // The scan slows down to keypad_idle_scanrate after keypad_idle_timeout ms with no key active and goes back to
+    // keypad_scanrate on the first activity. While keys are held it runs at keypad_hold_scanrate, if set.
+    enum EScanRate : uint8_t { SCAN_RATE_IDLE, SCAN_RATE_ACTIVE, SCAN_RATE_HOLD, SCAN_RATE_COUNT };
+    struct ScanStats {
+      EScanRate rate;                     // Current rate
+      uint32_t scans[SCAN_RATE_COUNT];
+      uint32_t time_ms[SCAN_RATE_COUNT];  // Time spent at each rate
+      uint32_t switches;
+    };
+    ScanStats GetScanStats();
+    void ResetScanStats();
+
+    // Counters of the keypad's AftertouchLimit (see KeyEvent.h), all zero on a keypad without one
+    struct AftertouchStats {
+      uint32_t suppressed;  // Aftertouch events held back
+      uint32_t flushed;     // Held back pressure sent right before a release
+    };
+    AftertouchStats GetAftertouchStats();
+    void ResetAftertouchStats();
   }
 
   // namespace BKP  // Back up register, persistent ram after software reset.
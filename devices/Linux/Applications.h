@@ -0,0 +1,20 @@
+#pragma once
+
+// SYSTEM_APPLICATION
+#include "applications/Shell/Shell.h"
+#include "applications/Performance/Performance.h"
+#include "applications/Note/Note.h"
+#include "applications/Companion/Companion.h"
+#include "applications/CustomControlMap/CustomControlMap.h"
+
+// USER APPLICATION
+#include "applications/Lighting/Lighting.h"
+#include "applications/Dice/Dice.h"
+#include "applications/Reversi/Reversi.h"
+#include "applications/PolyPlayground/PolyPlayground.h"
+
+// BOOT ANIMATION
+#include "applications/Mystrix/MystrixBoot/MystrixBoot.h"
+
+#define OS_SHELL APPID("203 Systems", "Shell")
+#define DEFAULT_BOOTANIMATION APPID("203 Systems", "Mystrix Boot")
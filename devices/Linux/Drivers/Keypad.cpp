@@ -0,0 +1,329 @@
+// Define Device Keypad Function
+#include "Device.h"
+#include "MatrixOS.h"
+#include "timers.h"
+#include <algorithm>
+
+// Simulated keypad. Key readings come from the script file in MATRIXOS_SIM_KEYSCRIPT, one change per line:
+//   <ms> <x> <y> <reading>   Grid key
+//   <ms> fn <reading>        Function key
+//   <ms> tb <index> <reading> Touch bar key
+// <ms> is the time since keypad start and <reading> is the raw 0 - 65535 force. Lines starting with # are ignored.
+// The readings are then scanned at keypad_scanrate through KeyInfo::update, the same way the hardware drivers do,
+// including slowing down to keypad_idle_scanrate when no key is active.
+namespace Device::KeyPad
+{
+  StaticTimer_t keypad_timer_def;
+  TimerHandle_t keypad_timer;
+
+  // Scan rate follows the keys, see Device.h
+  EScanRate scan_rate = SCAN_RATE_ACTIVE;
+  uint32_t last_activity = 0;
+  uint32_t rate_since = 0;
+  ScanStats scan_stats = {};
+  // Set by the Reset*Stats() calls, the scan clears the stats it writes itself as it may run on the other core
+  std::atomic<bool> scan_stats_reset = {false};
+  std::atomic<bool> aftertouch_stats_reset = {false};
+
+  uint16_t ScanPeriod(EScanRate rate) {
+    uint16_t scanrate = rate == SCAN_RATE_IDLE ? keypad_idle_scanrate : rate == SCAN_RATE_HOLD ? keypad_hold_scanrate : keypad_scanrate;
+    uint16_t period = configTICK_RATE_HZ / scanrate;
+    return period ? period : 1;
+  }
+
+  struct ScriptEntry {
+    uint32_t time;
+    uint16_t keyID;
+    uint16_t reading;
+  };
+
+  vector<ScriptEntry> script;
+  size_t script_index = 0;
+  uint32_t start_time = 0;
+
+  Fract16 fnReading = 0;
+  Fract16 keypadReading[x_size][y_size];
+  Fract16 touchbarReading[touchbar_size];
+
+  Fract16* GetReading(uint16_t keyID) {
+    uint8_t keyClass = keyID >> 12;
+    switch (keyClass)
+    {
+      case 0:
+        if ((keyID & 0x0FFF) == 0)
+          return &fnReading;
+        break;
+      case 1:
+      {
+        int16_t x = (keyID & (0b0000111111000000)) >> 6;
+        int16_t y = keyID & (0b0000000000111111);
+        if (x < x_size && y < y_size)
+          return &keypadReading[x][y];
+        break;
+      }
+      case 2:
+      {
+        uint16_t index = keyID & (0b0000111111111111);
+        if (index < touchbar_size)
+          return &touchbarReading[index];
+        break;
+      }
+    }
+    return nullptr;
+  }
+
+  void LoadScript(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr)
+    {
+      MLOGE("Keypad", "Failed to open key script %s", path);
+      return;
+    }
+
+    char line[128];
+    uint32_t line_number = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+      line_number++;
+      if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+      { continue; }
+
+      unsigned long time;
+      int x, y;
+      unsigned int reading;
+      ScriptEntry entry;
+      if (sscanf(line, "%lu fn %u", &time, &reading) == 2)
+      { entry.keyID = 0; }
+      else if (sscanf(line, "%lu tb %d %u", &time, &x, &reading) == 3 && x >= 0 && x < touchbar_size)
+      { entry.keyID = (2 << 12) + x; }
+      else if (sscanf(line, "%lu %d %d %u", &time, &x, &y, &reading) == 4 && x >= 0 && x < x_size && y >= 0 && y < y_size)
+      { entry.keyID = (1 << 12) + (x << 6) + y; }
+      else
+      {
+        MLOGW("Keypad", "Invalid key script line %d", line_number);
+        continue;
+      }
+      entry.time = time;
+      entry.reading = reading > UINT16_MAX ? UINT16_MAX : reading;
+      script.push_back(entry);
+    }
+    fclose(file);
+
+    std::stable_sort(script.begin(), script.end(), [](const ScriptEntry& a, const ScriptEntry& b) { return a.time < b.time; });
+    MLOGI("Keypad", "Loaded %d key script entries", script.size());
+  }
+
+  void Init() {
+    keypad_config.UpdateCurveScale();
+    const char* path = GetEnv("MATRIXOS_SIM_KEYSCRIPT");
+    if (path)
+    { LoadScript(path); }
+  }
+
+  void Start() {
+    start_time = MatrixOS::SYS::Millis();
+    last_activity = start_time;
+    rate_since = start_time;
+    keypad_timer = xTimerCreateStatic(NULL, ScanPeriod(SCAN_RATE_ACTIVE), true, NULL, reinterpret_cast<TimerCallbackFunction_t>(Scan), &keypad_timer_def);
+    xTimerStart(keypad_timer, 0);
+  }
+
+  // Return true if any key is not idle or the scan got interrupted
+  bool ScanKeys() {
+    bool active = false;
+    if (fnState.update(binary_config, fnReading))
+    {
+      if (NotifyOS(0, &fnState))
+      { return true; }
+    }
+    active |= fnState.state != IDLE;
+
+    for (uint8_t y = 0; y < y_size; y++)
+    {
+      for (uint8_t x = 0; x < x_size; x++)
+      {
+        if (keypadState[x][y].update(velocity_sensitivity ? keypad_config : binary_config, keypadReading[x][y]))
+        {
+          uint16_t keyID = (1 << 12) + (x << 6) + y;
+          if (NotifyOS(keyID, &keypadState[x][y]))
+          { return true; }
+        }
+        active |= keypadState[x][y].state != IDLE;
+      }
+    }
+
+    for (uint8_t i = 0; i < touchbar_size; i++)
+    {
+      if (touchbarState[i].update(binary_config, touchbarReading[i]))
+      {
+        uint16_t keyID = (2 << 12) + i;
+        if (NotifyOS(keyID, &touchbarState[i]))
+        { return true; }
+      }
+      active |= touchbarState[i].state != IDLE;
+    }
+    return active;
+  }
+
+  void ApplyStatsReset() {
+    if (scan_stats_reset.exchange(false))
+    {
+      scan_stats = {};
+      rate_since = MatrixOS::SYS::Millis();
+    }
+    if (aftertouch_stats_reset.exchange(false))
+    {
+      keypad_aftertouch.suppressed = 0;
+      keypad_aftertouch.flushed = 0;
+    }
+  }
+
+  void UpdateScanRate(bool active) {
+    uint32_t now = MatrixOS::SYS::Millis();
+    scan_stats.scans[scan_rate]++;
+    if (active)
+    { last_activity = now; }
+
+    EScanRate new_rate = SCAN_RATE_ACTIVE;
+    if (active && keypad_hold_scanrate)
+    { new_rate = SCAN_RATE_HOLD; }
+    else if (!active && keypad_idle_scanrate && now - last_activity > keypad_idle_timeout)
+    { new_rate = SCAN_RATE_IDLE; }
+
+    if (new_rate == scan_rate)
+    { return; }
+
+    scan_stats.time_ms[scan_rate] += now - rate_since;
+    scan_stats.switches++;
+    rate_since = now;
+    scan_rate = new_rate;
+    xTimerChangePeriod(keypad_timer, ScanPeriod(new_rate), 0);
+  }
+
+  ScanStats GetScanStats() {
+    if (scan_stats_reset)
+    { return {.rate = scan_rate}; }
+    ScanStats stats = scan_stats;
+    stats.rate = scan_rate;
+    stats.time_ms[scan_rate] += MatrixOS::SYS::Millis() - rate_since;
+    return stats;
+  }
+
+  void ResetScanStats() {
+    scan_stats_reset = true;
+  }
+
+  AftertouchStats GetAftertouchStats() {
+    if (aftertouch_stats_reset)
+    { return {}; }
+    return {keypad_aftertouch.suppressed, keypad_aftertouch.flushed};
+  }
+
+  void ResetAftertouchStats() {
+    aftertouch_stats_reset = true;
+  }
+
+  void Scan() {
+    ApplyStatsReset();
+    uint32_t now = MatrixOS::SYS::Millis() - start_time;
+    while (script_index < script.size() && script[script_index].time <= now)
+    {
+      Fract16* reading = GetReading(script[script_index].keyID);
+      if (reading)
+      { *reading = script[script_index].reading; }
+      script_index++;
+    }
+
+    UpdateScanRate(ScanKeys());
+  }
+
+  void Clear() {
+    fnState.Clear();
+
+    for (uint8_t x = 0; x < x_size; x++)
+    {
+      for (uint8_t y = 0; y < y_size; y++)
+      { keypadState[x][y].Clear(); }
+    }
+
+    for (uint8_t i = 0; i < touchbar_size; i++)
+    { touchbarState[i].Clear(); }
+  }
+
+  KeyInfo* GetKey(uint16_t keyID) {
+    uint8_t keyClass = keyID >> 12;
+    switch (keyClass)
+    {
+      case 0:  // System
+      {
+        uint16_t index = keyID & (0b0000111111111111);
+        switch (index)
+        {
+          case 0:
+            return &fnState;
+        }
+        break;
+      }
+      case 1:  // Main Grid
+      {
+        int16_t x = (keyID & (0b0000111111000000)) >> 6;
+        int16_t y = keyID & (0b0000000000111111);
+        if (x < x_size && y < y_size)
+          return &keypadState[x][y];
+        break;
+      }
+      case 2:  // Touch Bar
+      {
+        uint16_t index = keyID & (0b0000111111111111);
+        if (index < touchbar_size)
+          return &touchbarState[index];
+        break;
+      }
+    }
+    return nullptr;  // Return an empty KeyInfo
+  }
+
+  bool NotifyOS(uint16_t keyID, KeyInfo* keyInfo) {
+    KeyEvent keyEvent;
+    keyEvent.id = keyID;
+    keyEvent.info = *keyInfo;
+    keyEvent.timestamp = Device::Micros();
+    return MatrixOS::KEYPAD::NewEvent(&keyEvent);
+  }
+
+  uint16_t XY2ID(Point xy) {
+    if (xy.x >= 0 && xy.x < 8 && xy.y >= 0 && xy.y < 8)  // Main grid
+    { return (1 << 12) + (xy.x << 6) + xy.y; }
+    else if ((xy.x == -1 || xy.x == 8) && (xy.y >= 0 && xy.y < 8))  // Touch Bar
+    { return (2 << 12) + xy.y + (xy.x == 8) * 8; }
+    return UINT16_MAX;
+  }
+
+  Point ID2XY(uint16_t keyID) {
+    uint8_t keyClass = keyID >> 12;
+    switch (keyClass)
+    {
+      case 1:  // Main Grid
+      {
+        int16_t x = (keyID & 0b0000111111000000) >> 6;
+        int16_t y = keyID & (0b0000000000111111);
+        if (x < Device::x_size && y < Device::y_size)
+          return Point(x, y);
+        break;
+      }
+      case 2:  // TouchBar
+      {
+        uint16_t index = keyID & (0b0000111111111111);
+        if (index < Device::touchbar_size)
+        {
+          if (index / 8)  // Right
+          { return Point(Device::x_size, index % 8); }
+          else  // Left
+          { return Point(-1, index % 8); }
+        }
+        break;
+      }
+    }
+    return Point(INT16_MIN, INT16_MIN);
+  }
+}
@@ -0,0 +1,121 @@
+#include "Device.h"
+#include "MatrixOS.h"
+
+// Simulated LED strip. Each rendered frame is scaled the same way the WS2812 driver does it and, when
+// MATRIXOS_SIM_FRAMEBUFFER is set, written as packed RGB (led_count * 3 bytes) to the start of that file so an external
+// viewer can poll it.
+namespace Device
+{
+  namespace LED
+  {
+    FILE* framebuffer_file = nullptr;
+    vector<uint8_t> output_buffer;
+    uint32_t frame_count = 0;
+
+    void Init() {
+      output_buffer.resize(led_count * 3);
+      const char* path = GetEnv("MATRIXOS_SIM_FRAMEBUFFER");
+      if (path)
+      {
+        framebuffer_file = fopen(path, "wb");
+        if (framebuffer_file == nullptr)
+        { MLOGE("LED", "Failed to open framebuffer file %s", path); }
+      }
+    }
+
+    void Start() {}
+
+    void WriteFramebufferFile() {
+      frame_count++;
+
+      if (framebuffer_file)
+      {
+        fseek(framebuffer_file, 0, SEEK_SET);
+        fwrite(output_buffer.data(), 1, output_buffer.size(), framebuffer_file);
+        fflush(framebuffer_file);
+      }
+    }
+
+    bool Update(Color* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions)  // Render LED
+    {
+      if (dirtyPartitions == 0)
+      { return true; }
+
+      for (uint8_t partition = 0; partition < led_partitions.size() && partition < brightness.size(); partition++)
+      {
+        if ((dirtyPartitions & (1UL << partition)) == 0)
+        { continue; }
+
+        uint16_t end = led_partitions[partition].start + led_partitions[partition].size;
+        for (uint16_t index = led_partitions[partition].start; index < end; index++)
+        {
+          output_buffer[index * 3] = Color::scale8_video(frameBuffer[index].R, brightness[partition]);
+          output_buffer[index * 3 + 1] = Color::scale8_video(frameBuffer[index].G, brightness[partition]);
+          output_buffer[index * 3 + 2] = Color::scale8_video(frameBuffer[index].B, brightness[partition]);
+        }
+      }
+      WriteFramebufferFile();
+      return true;
+    }
+
+    bool Update(Color16* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions)
+    {
+      for (uint8_t partition = 0; partition < led_partitions.size() && partition < brightness.size(); partition++)
+      {
+        if ((dirtyPartitions & (1UL << partition)) == 0)
+        { continue; }
+
+        uint16_t end = led_partitions[partition].start + led_partitions[partition].size;
+        for (uint16_t index = led_partitions[partition].start; index < end; index++)
+        {
+          Color color = frameBuffer[index].Scale(brightness[partition] * 257).To8bits();
+          output_buffer[index * 3] = color.R;
+          output_buffer[index * 3 + 1] = color.G;
+          output_buffer[index * 3 + 2] = color.B;
+        }
+      }
+      WriteFramebufferFile();
+      return true;
+    }
+
+    uint16_t XY2Index(Point xy) {
+      if (xy.x >= 0 && xy.x < 8 && xy.y >= 0 && xy.y < 8)  // Main grid
+      { return xy.x + xy.y * 8; }
+      else if (xy.x == 8 && xy.y >= 0 && xy.y < 8)  // Underglow Right Column
+      { return 64 + (7 - xy.y); }
+      else if (xy.y == 8 && xy.x >= 0 && xy.x < 8)  // Underglow Bottom Row
+      { return 88 + xy.x; }
+      else if (xy.x == -1 && xy.y >= 0 && xy.y < 8)  // Underglow Left Column
+      { return 80 + xy.y; }
+      else if (xy.y == -1 && xy.x >= 0 && xy.x < 8)  // Underglow Top Row
+      { return 72 + (7 - xy.x); }
+      return UINT16_MAX;
+    }
+
+    Point Index2XY(uint16_t index) {
+      if (index < 64)
+      { return Point(index % 8, index / 8); }
+      else if (index < 72)  // Underglow Right Column
+      { return Point(8, 7 - (index - 64)); }
+      else if (index < 80)  // Underglow Top Row
+      { return Point(7 - (index - 72), -1); }
+      else if (index < 88)  // Underglow Left Column
+      { return Point(-1, index - 80); }
+      else if (index < 96)  // Underglow Bottom Row
+      { return Point(index - 88, 8); }
+      return Point::Invalid();
+    }
+
+    uint16_t ID2Index(uint16_t ledID) {
+      uint8_t ledClass = ledID >> 12;
+      switch (ledClass)
+      {
+        case 0:
+          if (ledID < led_count)
+            return ledID;
+          break;
+      }
+      return UINT16_MAX;
+    }
+  }
+}
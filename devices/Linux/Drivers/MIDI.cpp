@@ -0,0 +1,36 @@
+#include "Device.h"
+#include "MatrixOS.h"
+
+// Loopback MIDI port. Everything the OS sends to this port is echoed back as input, which makes it possible to drive
+// and observe MIDI apps without a host connection. Set MATRIXOS_SIM_MIDI_LOG to also dump the packets to a file.
+namespace Device::MIDI
+{
+  MidiPort* midiPort;
+  TaskHandle_t portTaskHandle = NULL;
+  FILE* log_file = nullptr;
+
+  void portTask(void* param) {
+    MidiPort port = MidiPort("Loopback", MIDI_PORT_DEVICE_CUSTOM);
+    midiPort = &port;
+    MidiPacket packet;
+    while (true)
+    {
+      if (port.Get(&packet, portMAX_DELAY))
+      {
+        if (log_file)
+        {
+          fprintf(log_file, "%lu %02X %02X %02X\n", (unsigned long)MatrixOS::SYS::Millis(), packet.data[0], packet.data[1], packet.data[2]);
+          fflush(log_file);
+        }
+        port.Send(packet);
+      }
+    }
+  }
+
+  void Init() {
+    const char* path = GetEnv("MATRIXOS_SIM_MIDI_LOG");
+    if (path)
+    { log_file = fopen(path, "w"); }
+    xTaskCreate(portTask, "Loopback Midi Port", configMINIMAL_STACK_SIZE * 2, NULL, configMAX_PRIORITIES - 2, &portTaskHandle);
+  }
+}
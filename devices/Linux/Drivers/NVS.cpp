@@ -0,0 +1,88 @@
+#include "Device.h"
+#include "MatrixOS.h"
+#include <map>
+
+// File backed NVS. The whole store is kept in memory and rewritten to MATRIXOS_SIM_NVS (default ./matrixos_nvs.bin) on
+// every change. The file is a list of [uint32_t hash][uint16_t length][data] records.
+namespace Device::NVS
+{
+  std::map<uint32_t, vector<char>> storage;
+  const char* storage_path = "matrixos_nvs.bin";
+
+  void Commit() {
+    FILE* file = fopen(storage_path, "wb");
+    if (file == nullptr)
+    {
+      MLOGE("NVS", "Failed to write %s", storage_path);
+      return;
+    }
+    for (auto& [hash, value] : storage)
+    {
+      uint16_t length = value.size();
+      fwrite(&hash, sizeof(hash), 1, file);
+      fwrite(&length, sizeof(length), 1, file);
+      fwrite(value.data(), 1, length, file);
+    }
+    fclose(file);
+  }
+
+  void Init() {
+    const char* path = GetEnv("MATRIXOS_SIM_NVS");
+    if (path)
+    { storage_path = path; }
+
+    FILE* file = fopen(storage_path, "rb");
+    if (file == nullptr)
+    { return; }  // First boot
+
+    uint32_t hash;
+    uint16_t length;
+    while (fread(&hash, sizeof(hash), 1, file) == 1 && fread(&length, sizeof(length), 1, file) == 1)
+    {
+      vector<char> value(length);
+      if (fread(value.data(), 1, length, file) != length)
+      {
+        MLOGW("NVS", "%s is truncated, dropping the last entry", storage_path);
+        break;
+      }
+      storage[hash] = value;
+    }
+    fclose(file);
+  }
+
+  size_t Size(uint32_t hash) {
+    auto it = storage.find(hash);
+    if (it == storage.end())
+    { return -1; }
+    return it->second.size();
+  }
+
+  vector<char> Read(uint32_t hash) {
+    auto it = storage.find(hash);
+    if (it == storage.end())
+    { return vector<char>(0); }
+    return it->second;
+  }
+
+  bool Write(uint32_t hash, void* pointer, uint16_t length) {
+    vector<char> value((char*)pointer, (char*)pointer + length);
+    auto it = storage.find(hash);
+    if (it != storage.end() && it->second == value)  // Skip duplicated write
+    { return true; }
+    storage[hash] = value;
+    Commit();
+    return true;
+  }
+
+  bool Delete(uint32_t hash) {
+    if (storage.erase(hash) == 0)
+    { return false; }
+    Commit();
+    return true;
+  }
+
+  void Clear() {
+    storage.clear();
+    Commit();
+  }
+}
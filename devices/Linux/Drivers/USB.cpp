@@ -0,0 +1,68 @@
+#include "Device.h"
+#include "device/dcd.h"
+
+namespace Device::USB
+{
+  void Init() {}
+}
+
+// There is no USB controller on the host. This null device controller driver lets TinyUSB link and run, it simply never
+// gets enumerated so every USB port stays disconnected.
+extern "C" {
+void dcd_init(uint8_t rhport) {
+  (void)rhport;
+}
+
+void dcd_int_enable(uint8_t rhport) {
+  (void)rhport;
+}
+
+void dcd_int_disable(uint8_t rhport) {
+  (void)rhport;
+}
+
+void dcd_set_address(uint8_t rhport, uint8_t dev_addr) {
+  (void)rhport;
+  (void)dev_addr;
+}
+
+void dcd_remote_wakeup(uint8_t rhport) {
+  (void)rhport;
+}
+
+void dcd_connect(uint8_t rhport) {
+  (void)rhport;
+}
+
+void dcd_disconnect(uint8_t rhport) {
+  (void)rhport;
+}
+
+bool dcd_edpt_open(uint8_t rhport, tusb_desc_endpoint_t const* desc_ep) {
+  (void)rhport;
+  (void)desc_ep;
+  return false;
+}
+
+void dcd_edpt_close_all(uint8_t rhport) {
+  (void)rhport;
+}
+
+bool dcd_edpt_xfer(uint8_t rhport, uint8_t ep_addr, uint8_t* buffer, uint16_t total_bytes) {
+  (void)rhport;
+  (void)ep_addr;
+  (void)buffer;
+  (void)total_bytes;
+  return false;
+}
+
+void dcd_edpt_stall(uint8_t rhport, uint8_t ep_addr) {
+  (void)rhport;
+  (void)ep_addr;
+}
+
+void dcd_edpt_clear_stall(uint8_t rhport, uint8_t ep_addr) {
+  (void)rhport;
+  (void)ep_addr;
+}
+}
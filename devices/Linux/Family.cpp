@@ -0,0 +1,95 @@
+#include "Device.h"
+#include "MatrixOS.h"
+#include "ui/UI.h"
+
+namespace Device
+{
+  void DeviceInit() {
+    USB::Init();
+    NVS::Init();
+    LED::Init();
+    KeyPad::Init();
+    MIDI::Init();
+  }
+
+  void DeviceStart() {
+    Device::KeyPad::Start();
+    Device::LED::Start();
+  }
+
+  void DeviceSettings() {
+    UI deviceSettings("Device Settings", Color(0x00FFAA));
+
+    UIButton clearNVSBtn;
+    clearNVSBtn.SetName("Clear Saved Data");
+    clearNVSBtn.SetColor(Color(0xFF0000));
+    clearNVSBtn.OnHold([]() -> void {
+      Device::NVS::Clear();
+      MatrixOS::SYS::Reboot();
+    });
+    deviceSettings.AddUIComponent(clearNVSBtn, Point(7, 0));
+
+    deviceSettings.Start();
+  }
+
+  // There is nothing to reboot into on the host, exit and let the user (or the script driving the simulator) restart it
+  void Bootloader() {
+    MLOGI("Device", "Bootloader requested, exiting simulator");
+    exit(0);
+  }
+
+  void Reboot() {
+    MLOGI("Device", "Reboot requested, exiting simulator");
+    exit(0);
+  }
+
+  void Log(string &format, va_list &valst) {
+    vprintf(format.c_str(), valst);
+    fflush(stdout);
+  }
+
+  string GetSerial() {
+    const char* serial = GetEnv("MATRIXOS_SIM_SERIAL");
+    return serial ? serial : "SIMULATOR";
+  }
+
+  uint32_t Micros() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000);
+  }
+
+  void ErrorHandler() {
+    abort();
+  }
+
+  const char* GetEnv(const char* name) {
+    const char* value = getenv(name);
+    if (value == nullptr || value[0] == '\0')
+    { return nullptr; }
+    return value;
+  }
+}
+
+// FreeRTOS static allocation hooks, provided by the port on the hardware families
+extern "C" {
+void vApplicationGetIdleTaskMemory(StaticTask_t** ppxIdleTaskTCBBuffer, StackType_t** ppxIdleTaskStackBuffer,
+                                   uint32_t* pulIdleTaskStackSize) {
+  static StaticTask_t idle_taskdef;
+  static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+  *ppxIdleTaskTCBBuffer = &idle_taskdef;
+  *ppxIdleTaskStackBuffer = idle_stack;
+  *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t** ppxTimerTaskTCBBuffer, StackType_t** ppxTimerTaskStackBuffer,
+                                    uint32_t* pulTimerTaskStackSize) {
+  static StaticTask_t timer_taskdef;
+  static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+  *ppxTimerTaskTCBBuffer = &timer_taskdef;
+  *ppxTimerTaskStackBuffer = timer_stack;
+  *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+}
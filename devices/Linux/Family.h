@@ -0,0 +1,47 @@
+// Declare Family specific function
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+#define FUNCTION_KEY 0  // Keypad Code for main function key
+
+#define DEVICE_SAVED_VAR_SCOPE "Device"
+
+namespace Device
+{
+  // Returns the environment variable or nullptr, used by the simulated drivers to locate their backing files
+  const char* GetEnv(const char* name);
+
+  namespace USB
+  {
+    void Init();
+  }
+
+  namespace LED
+  {
+    void Init();
+    void Start();
+  }
+
+  namespace KeyPad
+  {
+    void Init();
+    void Start();
+    void Scan();
+
+    bool NotifyOS(uint16_t keyID, KeyInfo* keyInfo);  // Passthrough MatrixOS::KeyPad::NewEvent() result
+  }
+
+  namespace NVS
+  {
+    void Init();
+  }
+
+  namespace MIDI
+  {
+    void Init();
+  }
+}
@@ -0,0 +1,89 @@
+// Define Device Specific Macro, Value and private function
+#pragma once
+
+#define GRID_8x8
+#define FAMILY MYSTRIX
+#define MODEL MX1
+
+#define MULTIPRESS 10  // Key Press will be process at once
+
+#include "Family.h"
+#include "framework/SavedVariable.h"
+
+struct DeviceInfo {
+  char Model[4];
+  char Revision[4];
+  uint8_t ProductionYear;
+  uint8_t ProductionMonth;
+};
+
+// Simulates a Mystrix Pro so the 8x8 applications and the velocity sensitive paths can run on the host
+namespace Device
+{
+  inline DeviceInfo deviceInfo = {{'M', 'X', '1', 'P'}, {'S', 'I', 'M', '0'}, 24, 1};
+
+  // Matrix OS required
+  inline string name = "Mystrix Simulator";
+  inline string model = "MX1P";
+
+  inline string manufacturer_name = "203 Systems";
+  inline string product_name = "Mystrix Simulator";
+  inline uint16_t usb_vid = 0x0203;
+  inline uint16_t usb_pid = 0x1040;
+
+  inline uint16_t led_count = 64 + 32;
+  inline uint8_t led_brightness_level[8] = {8, 22, 39, 60, 84, 110, 138, 169};
+  #define FINE_LED_BRIGHTNESS
+  inline uint8_t led_brightness_fine_level[16] = {8, 16, 26, 38, 50, 64, 80, 96, 112, 130, 149, 169, 189, 209, 232, 255};
+
+  inline vector<LEDPartition> led_partitions = {
+      {"Grid", 1.0, 0, 64},
+      {"Underglow", 4.0, 64, 32, 30},
+  };
+
+  // Device Specific
+  inline uint16_t keypad_scanrate = 480;
+  inline uint16_t keypad_idle_scanrate = 120;    // 0 to never slow down
+  inline uint32_t keypad_idle_timeout = 10000;  // ms
+  inline uint16_t keypad_hold_scanrate = 0;      // 0 to stay at keypad_scanrate while held
+  const uint8_t x_size = 8;
+  const uint8_t y_size = 8;
+  const uint8_t touchbar_size = 16;  // Not required by the API, private use.
+
+  namespace KeyPad
+  {
+    inline bool velocity_sensitivity = true;
+
+    inline KeyConfig binary_config = {
+        .apply_curve = false,
+        .low_threshold = 0,
+        .high_threshold = 65535,
+        .activation_offset = 0,
+        .debounce = 3,
+    };
+
+    inline AftertouchLimit keypad_aftertouch = {
+        .smoothing = 2,
+        .key_interval = 5,
+        .rate = 1000,
+        .burst = 32,
+    };
+
+    inline KeyConfig keypad_config = {
+        .apply_curve = true,
+        .low_threshold = 1536,
+        .high_threshold = 32767,
+        .activation_offset = 256,
+        .debounce = 10,
+        .aftertouch = &keypad_aftertouch,
+    };
+
+    inline KeyInfo fnState;
+    inline KeyInfo keypadState[x_size][y_size];
+    inline KeyInfo touchbarState[touchbar_size];
+  }
+
+// LED
+#define MAX_LED_LAYERS 8
+  const inline uint16_t fps = 120;  // Depends on the FreeRTOS tick speed
+}
@@ -0,0 +1,41 @@
+# Linux host simulator. Runs Matrix OS on the FreeRTOS POSIX port, with the LED, keypad, NVS and MIDI hardware replaced
+# by in-process stand-ins. Build with `make DEVICE=MystrixSim`, start with `make DEVICE=MystrixSim run` and run the host
+# tests with `make DEVICE=MystrixSim test`.
+
+MCU = host
+
+# Native toolchain
+CROSS_COMPILE =
+CFLAGS_OPTIMIZED = -O2
+
+include $(FAMILY_PATH)/Variants/$(DEVICE)/Device.mk
+
+CFLAGS += \
+  -pthread \
+  -DCFG_TUSB_MCU=OPT_MCU_NONE
+
+INC += \
+	$(DEVICE_PATH) \
+	$(FAMILY_PATH)/Drivers \
+	$(FREERTOS_SRC)/portable/ThirdParty/GCC/Posix/utils
+
+SRC_C += \
+	$(FREERTOS_SRC)/portable/ThirdParty/GCC/Posix/utils/wait_for_event.c
+
+# For freeRTOS port source
+FREERTOS_PORT_PATH = $(FREERTOS_SRC)/portable/ThirdParty/GCC/Posix
+
+# Hardware specific applications
+SRC_EXCLUDE += \
+	applications/Mystrix/FactoryMenu/% \
+	applications/Mystrix/ForceCalibration/% \
+	applications/WebExample/%
+
+.PHONY: run
+run: $(BUILD)/$(PROJECT).elf
+	./$<
+
+# Host tests, see tests/makefile
+.PHONY: test
+test:
+	$(MAKE) -C tests
@@ -48,7 +48,12 @@ namespace Device
       while (true)
       {
         if (port.Get(&packet, portMAX_DELAY))
-        { blemidi_send_message(port.id % 0x100, packet.data, 3); }
+        {
+          blemidi_send_message(port.id % 0x100, packet.data, 3);
+#ifdef MATRIXOS_LATENCY_TRACE
+          MatrixOS::SYS::TraceLatency(MatrixOS::SYS::TRACE_BLE_TX, packet.origin);
+#endif
+        }
       }
     }
 
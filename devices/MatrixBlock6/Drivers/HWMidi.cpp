@@ -16,7 +16,12 @@ namespace Device
             while (true)
             {
                 if (port.Get(&packet, portMAX_DELAY))
-                { uart_write_bytes(uartChannel, packet.data, 3); }
+                {
+                    uart_write_bytes(uartChannel, packet.data, 3);
+#ifdef MATRIXOS_LATENCY_TRACE
+                    MatrixOS::SYS::TraceLatency(MatrixOS::SYS::TRACE_UART_TX, packet.origin);
+#endif
+                }
             }
         }
 
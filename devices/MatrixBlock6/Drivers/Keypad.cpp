@@ -8,6 +8,23 @@ namespace Device::KeyPad
   StaticTimer_t keypad_timer_def;
   TimerHandle_t keypad_timer;
 
+  // Scan rate follows the keys, see Device.h
+  EScanRate scan_rate = SCAN_RATE_ACTIVE;
+  uint32_t last_activity = 0;
+  uint32_t rate_since = 0;
+  ScanStats scan_stats = {};
+  // Set by the Reset*Stats() calls, the scan clears the stats it writes itself as it may run on the other core
+  std::atomic<bool> scan_stats_reset = {false};
+  std::atomic<bool> aftertouch_stats_reset = {false};
+  extern TimerHandle_t touchbar_timer;
+  extern bool touchbar_active;
+
+  uint16_t ScanPeriod(EScanRate rate) {
+    uint16_t scanrate = rate == SCAN_RATE_IDLE ? keypad_idle_scanrate : rate == SCAN_RATE_HOLD ? keypad_hold_scanrate : keypad_scanrate;
+    uint16_t period = configTICK_RATE_HZ / scanrate;
+    return period ? period : 1;
+  }
+
   void Init() {
     InitFN();
     InitKeyPad();
@@ -51,7 +68,9 @@ namespace Device::KeyPad
       FSR::Start();
     }
 
-    keypad_timer = xTimerCreateStatic(NULL, configTICK_RATE_HZ / Device::keypad_scanrate, true, NULL, reinterpret_cast<TimerCallbackFunction_t>(Scan), &keypad_timer_def);
+    last_activity = MatrixOS::SYS::Millis();
+    rate_since = last_activity;
+    keypad_timer = xTimerCreateStatic(NULL, ScanPeriod(SCAN_RATE_ACTIVE), true, NULL, reinterpret_cast<TimerCallbackFunction_t>(Scan), &keypad_timer_def);
     
 
     xTimerStart(keypad_timer, 0);
@@ -63,8 +82,11 @@ namespace Device::KeyPad
   }
 
   void Scan() {
+    ApplyStatsReset();
     ScanFN();
-    ScanKeyPad();
+    bool interrupted = ScanKeyPad();
+    bool active = interrupted || touchbar_active || fnState.state != IDLE || (velocity_sensitivity ? FSR::Active() : Binary::Active());
+    UpdateScanRate(active);
   }
 
   bool ScanKeyPad() {
@@ -74,6 +96,72 @@ namespace Device::KeyPad
     { return FSR::Scan(); }
   }
 
+  // Runs on the timer task like the touch bar scan, so the touch bar timer can be changed here as well
+  void ApplyStatsReset() {
+    if (scan_stats_reset.exchange(false))
+    {
+      scan_stats = {};
+      rate_since = MatrixOS::SYS::Millis();
+    }
+    if (aftertouch_stats_reset.exchange(false))
+    {
+      keypad_aftertouch.suppressed = 0;
+      keypad_aftertouch.flushed = 0;
+    }
+  }
+
+  void UpdateScanRate(bool active) {
+    uint32_t now = MatrixOS::SYS::Millis();
+    scan_stats.scans[scan_rate]++;
+    if (active)
+    { last_activity = now; }
+
+    EScanRate new_rate = SCAN_RATE_ACTIVE;
+    if (active && keypad_hold_scanrate)
+    { new_rate = SCAN_RATE_HOLD; }
+    else if (!active && keypad_idle_scanrate && now - last_activity > keypad_idle_timeout)
+    { new_rate = SCAN_RATE_IDLE; }
+
+    if (new_rate == scan_rate)
+    { return; }
+
+    // The touch bar slows down with the keypad, it never scans faster than touchbar_scanrate
+    if (new_rate == SCAN_RATE_IDLE || scan_rate == SCAN_RATE_IDLE)
+    {
+      uint16_t touchbar_rate = new_rate == SCAN_RATE_IDLE ? std::min(touchbar_scanrate, keypad_idle_scanrate) : touchbar_scanrate;
+      xTimerChangePeriod(touchbar_timer, configTICK_RATE_HZ / touchbar_rate, 0);
+    }
+
+    scan_stats.time_ms[scan_rate] += now - rate_since;
+    scan_stats.switches++;
+    rate_since = now;
+    scan_rate = new_rate;
+    xTimerChangePeriod(keypad_timer, ScanPeriod(new_rate), 0);
+  }
+
+  ScanStats GetScanStats() {
+    if (scan_stats_reset)
+    { return {.rate = scan_rate}; }
+    ScanStats stats = scan_stats;
+    stats.rate = scan_rate;
+    stats.time_ms[scan_rate] += MatrixOS::SYS::Millis() - rate_since;
+    return stats;
+  }
+
+  void ResetScanStats() {
+    scan_stats_reset = true;
+  }
+
+  AftertouchStats GetAftertouchStats() {
+    if (aftertouch_stats_reset)
+    { return {}; }
+    return {keypad_aftertouch.suppressed, keypad_aftertouch.flushed};
+  }
+
+  void ResetAftertouchStats() {
+    aftertouch_stats_reset = true;
+  }
+
   bool ScanFN() {
     Fract16 read = gpio_get_level(fn_pin) * UINT16_MAX;
     // ESP_LOGI("FN", "%d", gpio_get_level(fn_pin));
@@ -137,6 +225,7 @@ namespace Device::KeyPad
     KeyEvent keyEvent;
     keyEvent.id = keyID;
     keyEvent.info = *keyInfo;
+    keyEvent.timestamp = Device::Micros();
     return MatrixOS::KEYPAD::NewEvent(&keyEvent);
   }
 
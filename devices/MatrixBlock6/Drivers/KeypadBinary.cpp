@@ -7,6 +7,12 @@
 
 namespace Device::KeyPad::Binary
 {
+  bool active = false;  // Any key not idle in the last scan
+
+  bool Active() {
+    return active;
+  }
+
   void Init() {
     gpio_config_t io_conf;
 
@@ -66,6 +72,7 @@ namespace Device::KeyPad::Binary
 
     bool Scan()
   {
+    active = false;
     for(uint8_t x = 0; x < Device::x_size; x++)
     {
       gpio_set_level(keypad_write_pins[x], 1);
@@ -73,12 +80,16 @@ namespace Device::KeyPad::Binary
       {
         Fract16 reading = gpio_get_level(keypad_read_pins[y]) * FRACT16_MAX;
         // MLOGD("Keypad", "%d %d Read: %d", x, y, gpio_get_level(keypad_read_pins[y]));
+        if (reading == 0 && keypadState[x][y].state == IDLE)  // update() would do nothing
+        { continue; }
         bool updated = keypadState[x][y].update(binary_config, reading);
+        active |= keypadState[x][y].state != IDLE;
         if (updated)
         {
           uint16_t keyID = (1 << 12) + (x << 6) + y;
           if (NotifyOS(keyID, &keypadState[x][y]))
-          {           
+          {
+            gpio_set_level(keypad_write_pins[x], 0);
             return true; 
           }
         }
@@ -17,6 +17,8 @@ extern const uint8_t ulp_fsr_keypad_bin_end[] asm("_binary_ulp_fsr_keypad_bin_en
 
 #define FORCE_CALIBRATION_LOW_HASH StaticHash("MATRIX—FORCE-CALIBRATION-LOW")
 #define FORCE_CALIBRATION_HIGH_HASH StaticHash("MATRIX—FORCE-CALIBRATION-HIGH")
+#define FORCE_VELOCITY_CURVE_HASH StaticHash("MATRIX—FORCE-VELOCITY-CURVE")
+#define MAX_VELOCITY_CURVE_POINTS 8
 
 
 namespace MatrixOS::USB
@@ -31,6 +33,66 @@ namespace Device::KeyPad::FSR
 
   CreateSavedVar("ForceCalibration", lowOffset, int16_t, 0);
   CreateSavedVar("ForceCalibration", highOffset, int16_t, 0);
+  CreateSavedVar("ForceCalibration", velocityCurveShape, uint8_t, VELOCITY_CURVE_LINEAR);
+
+  // Calibration with the offsets applied and clamped, so Scan() does no math on them. Rebuilt on every change.
+  KeyConfig key_configs[x_size][y_size];
+  VelocityCurve velocity_curve;
+
+  // Scan() only visits keys the ULP flagged as changed, plus the ones that are not idle so hold and aftertouch keep
+  // their timing. The ULP flags a key once its reading is over the press threshold, so an idle key that isn't flagged
+  // would not have done anything in KeyInfo::update anyways. Bit y * 8 + x, same as the ULP's changed bitmap.
+  static_assert(x_size * y_size <= 64, "Key bitmaps are 64 bits");
+  uint64_t active_keys = 0;
+  uint64_t pending_keys = UINT64_MAX;  // Left over from a scan that got interrupted, all of them after a config change
+  uint32_t last_generation = 0;
+
+  #define CLAMP(x, low, high) (x < low ? low : (x > high ? high : x))
+  void UpdateULPThresholds() {
+    volatile uint16_t (*threshold)[8] = (volatile uint16_t (*)[8])&ulp_threshold;
+    for (uint8_t x = 0; x < x_size; x++)
+    {
+      for (uint8_t y = 0; y < y_size; y++)
+      {
+        uint32_t press_threshold = (uint16_t)key_configs[x][y].low_threshold + (uint16_t)key_configs[x][y].activation_offset;
+        threshold[x][y] = std::min(press_threshold, (uint32_t)UINT16_MAX);
+      }
+    }
+    pending_keys = UINT64_MAX;
+  }
+
+  void UpdateKeyConfigs() {
+    int16_t low_offset = lowOffset.Get();
+    int16_t high_offset = highOffset.Get();
+    for (uint8_t x = 0; x < x_size; x++)
+    {
+      for (uint8_t y = 0; y < y_size; y++)
+      {
+        // Built aside and assigned whole, the scan never sees a config half way through the update
+        KeyConfig config = keypad_config;
+        int32_t new_low_threshold = (uint16_t)(*low_thresholds)[x][y] + low_offset;
+        int32_t new_high_threshold = (uint16_t)(*high_thresholds)[x][y] + high_offset;
+        config.low_threshold = CLAMP(new_low_threshold, 512, UINT16_MAX);
+        config.high_threshold = CLAMP(new_high_threshold, 25600, UINT16_MAX);
+        config.velocity_curve = velocityCurveShape.Get() == VELOCITY_CURVE_LINEAR ? nullptr : &velocity_curve;
+        config.UpdateCurveScale();
+        key_configs[x][y] = config;
+      }
+    }
+    UpdateULPThresholds();
+  }
+
+  void UpdateVelocityCurve() {
+    if (velocityCurveShape.Get() == VELOCITY_CURVE_CUSTOM)
+    {
+      vector<char> points = MatrixOS::NVS::GetVariable(FORCE_VELOCITY_CURVE_HASH);
+      uint8_t count = std::min(points.size() / sizeof(VelocityCurvePoint), (size_t)MAX_VELOCITY_CURVE_POINTS);
+      velocity_curve.Build((const VelocityCurvePoint*)points.data(), count);
+    }
+    else
+    { velocity_curve.Build((EVelocityCurve)velocityCurveShape.Get()); }
+    UpdateKeyConfigs();
+  }
 
   void Init() {
     gpio_config_t io_conf;
@@ -87,16 +149,19 @@ namespace Device::KeyPad::FSR
 
     MatrixOS::NVS::GetVariable(FORCE_CALIBRATION_LOW_HASH, low_thresholds, sizeof(Fract16) * x_size * y_size);
     MatrixOS::NVS::GetVariable(FORCE_CALIBRATION_HIGH_HASH, high_thresholds, sizeof(Fract16) * x_size * y_size);
+    UpdateVelocityCurve();
   }
 
   void SaveLowCalibration()
   {
     MatrixOS::NVS::SetVariable(FORCE_CALIBRATION_LOW_HASH, low_thresholds, sizeof(Fract16) * x_size * y_size);
+    UpdateKeyConfigs();
   }
 
   void SaveHighCalibration()
   {
     MatrixOS::NVS::SetVariable(FORCE_CALIBRATION_HIGH_HASH, high_thresholds, sizeof(Fract16) * x_size * y_size);
+    UpdateKeyConfigs();
   }
 
   void ClearLowCalibration()
@@ -109,6 +174,7 @@ namespace Device::KeyPad::FSR
         (*low_thresholds)[x][y] = keypad_config.low_threshold;
       }
     }
+    UpdateKeyConfigs();
   }
 
   void ClearHighCalibration()
@@ -121,6 +187,7 @@ namespace Device::KeyPad::FSR
         (*high_thresholds)[x][y] = keypad_config.high_threshold;
       }
     }
+    UpdateKeyConfigs();
   }
 
   int16_t GetLowOffset()
@@ -136,11 +203,32 @@ namespace Device::KeyPad::FSR
   void SetLowOffset(int16_t offset)
   {
     lowOffset.Set(offset);
+    UpdateKeyConfigs();
   }
 
   void SetHighOffset(int16_t offset)
   {
     highOffset.Set(offset);
+    UpdateKeyConfigs();
+  }
+
+  EVelocityCurve GetVelocityCurve()
+  {
+    return (EVelocityCurve)velocityCurveShape.Get();
+  }
+
+  void SetVelocityCurve(EVelocityCurve shape)
+  {
+    velocityCurveShape.Set(shape);
+    UpdateVelocityCurve();
+  }
+
+  // Up to MAX_VELOCITY_CURVE_POINTS, sorted by input
+  void SetCustomVelocityCurve(const VelocityCurvePoint* points, uint8_t count)
+  {
+    count = std::min(count, (uint8_t)MAX_VELOCITY_CURVE_POINTS);
+    MatrixOS::NVS::SetVariable(FORCE_VELOCITY_CURVE_HASH, (void*)points, sizeof(VelocityCurvePoint) * count);
+    SetVelocityCurve(VELOCITY_CURVE_CUSTOM);
   }
 
   uint32_t GetScanCount()
@@ -157,33 +245,48 @@ namespace Device::KeyPad::FSR
   void Start() {
     ulp_riscv_halt();
     ulp_riscv_load_binary(ulp_fsr_keypad_bin_start, (ulp_fsr_keypad_bin_end - ulp_fsr_keypad_bin_start));
+    UpdateULPThresholds();  // Loading cleared them
     ulp_riscv_run();
   }
   
-  #define CLAMP(x, low, high) (x < low ? low : (x > high ? high : x))
+  bool Active() {
+    return active_keys != 0;
+  }
+
   bool Scan() {
     // ESP_LOGI("Keypad ULP", "Scaned: %lu", ulp_count);
     uint16_t (*result)[8][SAMPLES] = (uint16_t (*)[8][SAMPLES])&ulp_result;
-    // uint16_t(*threshold)[8] = (uint16_t(*)[8]) &ulp_threshold;
-    
 
-    KeyConfig config = keypad_config;
-    for (uint8_t y = 0; y < Device::y_size; y++)
+    uint64_t keys = active_keys | pending_keys;
+    uint32_t generation = ulp_count;
+    if (generation != last_generation)
     {
-      for (uint8_t x = 0; x < Device::x_size; x++)
+      volatile uint32_t* changed = (volatile uint32_t*)&ulp_changed;
+      keys |= changed[0] | ((uint64_t)changed[1] << 32);
+      last_generation = generation;
+    }
+    pending_keys = 0;
+
+    while (keys)
+    {
+      uint8_t bit = __builtin_ctzll(keys);
+      keys &= keys - 1;
+      uint8_t x = bit & 7;
+      uint8_t y = bit >> 3;
+
+      Fract16 reading = (Fract16)result[x][y][0];
+      bool updated = keypadState[x][y].update(key_configs[x][y], reading);
+      if (keypadState[x][y].state == IDLE)
+      { active_keys &= ~(1ULL << bit); }
+      else
+      { active_keys |= 1ULL << bit; }
+      if (updated)
       {
-        Fract16 reading = (Fract16)result[x][y][0];
-        int32_t new_low_threshold = (uint16_t)(*low_thresholds)[x][y] + lowOffset.Get();
-        int32_t new_high_threshold = (uint16_t)(*high_thresholds)[x][y] + highOffset.Get();
-        
-        config.low_threshold = CLAMP(new_low_threshold, 512, UINT16_MAX);
-        config.high_threshold = CLAMP(new_high_threshold, 25600, UINT16_MAX);
-        bool updated = keypadState[x][y].update(config, reading);
-        if (updated)
+        uint16_t keyID = (1 << 12) + (x << 6) + y;
+        if (NotifyOS(keyID, &keypadState[x][y]))
         {
-          uint16_t keyID = (1 << 12) + (x << 6) + y;
-          if (NotifyOS(keyID, &keypadState[x][y]))
-          { return true; }
+          pending_keys = keys;
+          return true;
         }
       }
     }
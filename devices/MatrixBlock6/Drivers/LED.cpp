@@ -13,9 +13,14 @@ namespace Device
 
     void Start() {}
 
-    void Update(Color* frameBuffer, vector<uint8_t>& brightness)  // Render LED
+    bool Update(Color* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions)  // Render LED
     {
-      WS2812::Show(frameBuffer, brightness);
+      return WS2812::Show(frameBuffer, brightness, dirtyPartitions);
+    }
+
+    bool Update(Color16* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions)
+    {
+      return WS2812::Show(frameBuffer, brightness, dirtyPartitions);
     }
 
     uint16_t XY2Index(Point xy) {
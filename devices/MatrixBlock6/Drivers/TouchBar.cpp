@@ -8,10 +8,11 @@ namespace Device::KeyPad
 
   StaticTimer_t touchbar_timer_def;
   TimerHandle_t touchbar_timer;
+  bool touchbar_active = false;  // Keeps the keypad scan from going idle
 
   void TouchBarTimerHandler()  // This exists because return type of TouchBarScan is bool
   {
-    if(touchbar_enable) ScanTouchBar();
+    touchbar_active = touchbar_enable && ScanTouchBar();
   }
 
   void InitTouchBar() {
@@ -41,7 +42,9 @@ namespace Device::KeyPad
     xTimerStart(touchbar_timer, 0);
   }
 
+  // Return true if any touch bar key is active or the scan got interrupted
   bool ScanTouchBar() {
+    bool active = false;
     for (uint8_t i = 0; i < touchbar_size; i++)
     {
       gpio_set_level(touchClock_Pin, 1);
@@ -52,6 +55,7 @@ namespace Device::KeyPad
 
       uint8_t key_id = touchbar_map[i];
       bool updated = touchbarState[key_id].update(binary_config, reading);
+      active |= touchbarState[key_id].state != IDLE;
       if (updated)
       {
         uint16_t keyID = (2 << 12) + key_id;
@@ -59,6 +63,6 @@ namespace Device::KeyPad
         { return true; }
       }
     }
-    return false;
+    return active;
   }
 }
\ No newline at end of file
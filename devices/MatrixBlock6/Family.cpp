@@ -6,6 +6,7 @@
 
 #include "esp_efuse.h"
 #include "esp_efuse_table.h"
+#include "esp_timer.h"
 
 namespace Device
 {
@@ -136,6 +137,10 @@ namespace Device
     // return 0;
   }
 
+  uint32_t Micros() {
+    return (uint32_t)esp_timer_get_time();
+  }
+
   void Log(string &format, va_list &valst) {
     // ESP_LOG_LEVEL((esp_log_level_t)level, tag.c_str(), format.c_str(), valst);
     // esp_log_writev(ESP_LOG_INFO, format.c_str(), valst);
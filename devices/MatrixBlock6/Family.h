@@ -44,11 +44,15 @@ namespace Device
     bool ScanFN();
     bool ScanTouchBar();
 
+    void ApplyStatsReset();            // Clear the stats a Reset*Stats() call asked for, on the scanning task
+    void UpdateScanRate(bool active);  // Called after every keypad scan with whether any key is not idle
+
     namespace Binary
     {
       void Init();
       void Start();
       bool Scan();
+      bool Active();
     }
 
     namespace FSR
@@ -56,6 +60,7 @@ namespace Device
       void Init();
       void Start();
       bool Scan();
+      bool Active();
     }
 
     bool NotifyOS(uint16_t keyID, KeyInfo* keyInfo);  // Passthrough MatrixOS::KeyPad::NewEvent() result
@@ -36,7 +36,39 @@ volatile adc_channel_t keypad_read_adc_channel[Y_SIZE] =
 
 volatile uint16_t result[X_SIZE][Y_SIZE];
 
-volatile uint32_t count;
+// Written by the main core before the ULP starts and whenever the calibration changes, a key resting under it is idle
+volatile uint16_t threshold[X_SIZE][Y_SIZE];
+
+// Keys whose result is above their threshold, bit y * 8 + x. Rewritten every pass
+volatile uint32_t changed[2];
+
+volatile uint32_t count;  // Passes done, bumped after changed is written so it doubles as its generation
+
+// One pass over the keypad: read every key into its filtered result and flag the ones over their threshold in changed.
+// Not static, so the host tests can run the ULP a pass at a time.
+void scan_keypad(void)
+{
+  uint32_t changed_keys[2] = {0, 0};
+  for (uint8_t x = 0; x < X_SIZE; x++)
+  {
+    ulp_riscv_gpio_output_level(keypad_write_pins[x], 1);
+    for (uint8_t y = 0; y < Y_SIZE; y++)
+    {
+      uint16_t reading = ulp_riscv_adc_read_channel(ADC_UNIT_1, keypad_read_adc_channel[y]);
+      reading = (reading << 4) + (reading >> 8); 
+
+      uint16_t filtered = (result[x][y] * (IIF_LENGTH - 1) + reading) / IIF_LENGTH;
+      result[x][y] = filtered;
+
+      if (filtered > threshold[x][y])
+      { changed_keys[y >> 2] |= 1UL << (((y & 3) << 3) + x); }
+    }
+    ulp_riscv_gpio_output_level(keypad_write_pins[x], 0);
+  }
+  changed[0] = changed_keys[0];
+  changed[1] = changed_keys[1];
+  count++;
+}
 
 int main(void)
 {
@@ -56,18 +88,6 @@ int main(void)
 
   while(true)
   {
-    for (uint8_t x = 0; x < X_SIZE; x++)
-    {
-      ulp_riscv_gpio_output_level(keypad_write_pins[x], 1);
-      for (uint8_t y = 0; y < Y_SIZE; y++)
-      {
-        uint16_t reading = ulp_riscv_adc_read_channel(ADC_UNIT_1, keypad_read_adc_channel[y]);
-        reading = (reading << 4) + (reading >> 8); 
-
-        result[x][y] = (result[x][y] * (IIF_LENGTH - 1) + reading) / IIF_LENGTH;
-      }
-      ulp_riscv_gpio_output_level(keypad_write_pins[x], 0);
-    }
-    count++;
+    scan_keypad();
   }
 }
\ No newline at end of file
@@ -62,11 +62,14 @@ namespace Device
 
   inline vector<LEDPartition> led_partitions = {
       {"Grid", 1.0, 0, 64},
-      {"Underglow", 4.0, 64, 32},
+      {"Underglow", 4.0, 64, 32, 30},
   };
 
   // Device Specific
   inline uint16_t keypad_scanrate = 480;
+  inline uint16_t keypad_idle_scanrate = 120;    // 0 to never slow down
+  inline uint32_t keypad_idle_timeout = 10000;  // ms
+  inline uint16_t keypad_hold_scanrate = 0;      // 0 to stay at keypad_scanrate while held
   inline uint16_t touchbar_scanrate = 60;
   const uint8_t x_size = 8;
   const uint8_t y_size = 8;
@@ -86,12 +89,20 @@ namespace Device
         .debounce = 3,
     };
 
+    inline AftertouchLimit keypad_aftertouch = {
+        .smoothing = 2,
+        .key_interval = 5,
+        .rate = 1000,
+        .burst = 32,
+    };
+
     inline KeyConfig keypad_config = {
         .apply_curve = true,
         .low_threshold = 1536,
         .high_threshold = 32767,
         .activation_offset = 256,
         .debounce = 10,
+        .aftertouch = &keypad_aftertouch,
     };
 
     inline gpio_num_t keypad_write_pins[8];
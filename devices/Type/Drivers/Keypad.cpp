@@ -1,5 +1,6 @@
 // Define Device Keypad Function
 #include "Device.h"
+#include "MatrixOS.h"
 #include "timers.h"
 
 #include "ulp_riscv.h"
@@ -18,14 +19,79 @@ namespace Device::KeyPad
   StaticTimer_t keypad_timer_def;
   TimerHandle_t keypad_timer;
 
+  // Scan rate follows the keys, see Device.h. The ULP keeps scanning the matrix, only the readout slows down.
+  EScanRate scan_rate = SCAN_RATE_ACTIVE;
+  uint32_t last_activity = 0;
+  uint32_t rate_since = 0;
+  ScanStats scan_stats = {};
+  std::atomic<bool> scan_stats_reset = {false};  // Set by ResetScanStats(), cleared by the scan on the timer task
+  bool active = false;  // Any key not idle in the last scan
+
+  uint16_t ScanPeriod(EScanRate rate) {
+    uint16_t scanrate = rate == SCAN_RATE_IDLE ? keypad_idle_scanrate : rate == SCAN_RATE_HOLD ? keypad_hold_scanrate : keypad_scanrate;
+    uint16_t period = configTICK_RATE_HZ / scanrate;
+    return period ? period : 1;
+  }
+
+  Point KeyGridRemap(Point hwPoint);
+  Point keyGridTable[write_size][read_size];  // KeyGridRemap() result for every hardware key, filled by InitKeyPad()
+
   void Init() {
     InitKeyPad();
   }
 
   void Scan() {
-    ScanKeyPad();
+    if (scan_stats_reset.exchange(false))
+    {
+      scan_stats = {};
+      rate_since = MatrixOS::SYS::Millis();
+    }
+    bool interrupted = ScanKeyPad();
+    UpdateScanRate(interrupted || active);
+  }
+
+  void UpdateScanRate(bool active) {
+    uint32_t now = MatrixOS::SYS::Millis();
+    scan_stats.scans[scan_rate]++;
+    if (active)
+    { last_activity = now; }
+
+    EScanRate new_rate = SCAN_RATE_ACTIVE;
+    if (active && keypad_hold_scanrate)
+    { new_rate = SCAN_RATE_HOLD; }
+    else if (!active && keypad_idle_scanrate && now - last_activity > keypad_idle_timeout)
+    { new_rate = SCAN_RATE_IDLE; }
+
+    if (new_rate == scan_rate)
+    { return; }
+
+    scan_stats.time_ms[scan_rate] += now - rate_since;
+    scan_stats.switches++;
+    rate_since = now;
+    scan_rate = new_rate;
+    xTimerChangePeriod(keypad_timer, ScanPeriod(new_rate), 0);
   }
 
+  ScanStats GetScanStats() {
+    if (scan_stats_reset)
+    { return {.rate = scan_rate}; }
+    ScanStats stats = scan_stats;
+    stats.rate = scan_rate;
+    stats.time_ms[scan_rate] += MatrixOS::SYS::Millis() - rate_since;
+    return stats;
+  }
+
+  void ResetScanStats() {
+    scan_stats_reset = true;
+  }
+
+  // Binary keys, no aftertouch to limit
+  AftertouchStats GetAftertouchStats() {
+    return {};
+  }
+
+  void ResetAftertouchStats() {}
+
   void InitKeyPad() {
     gpio_config_t io_conf;
 
@@ -53,7 +119,7 @@ namespace Device::KeyPad
     for (uint8_t write_id = 0; write_id < write_size; write_id++)
     {
       for (uint8_t read_id = 0; read_id < read_size; read_id++)
-      { keypadState[write_id][read_id].setConfig(&keypad_config); }
+      { keyGridTable[write_id][read_id] = KeyGridRemap(Point(write_id, read_id)); }
     }
   }
 
@@ -61,7 +127,9 @@ namespace Device::KeyPad
     ulp_riscv_load_binary(ulp_keypad_bin_start, (ulp_keypad_bin_end - ulp_keypad_bin_start));
     ulp_riscv_run();
 
-    keypad_timer = xTimerCreateStatic(NULL, configTICK_RATE_HZ / Device::keypad_scanrate, true, NULL, reinterpret_cast<TimerCallbackFunction_t>(Scan), &keypad_timer_def);
+    last_activity = MatrixOS::SYS::Millis();
+    rate_since = last_activity;
+    keypad_timer = xTimerCreateStatic(NULL, ScanPeriod(SCAN_RATE_ACTIVE), true, NULL, reinterpret_cast<TimerCallbackFunction_t>(Scan), &keypad_timer_def);
     xTimerStart(keypad_timer, 0);
   }
 
@@ -122,14 +190,16 @@ namespace Device::KeyPad
   {
     // ESP_LOGI("Keypad ULP", "Scanned: %lu", ulp_count);
     uint8_t (*result)[read_size] = (uint8_t(*)[read_size])&ulp_result;
+    active = false;
     for(uint8_t hw_y = 0; hw_y < read_size; hw_y ++)
     {
       for(uint8_t hw_x = 0; hw_x < write_size; hw_x++)
       {
         Fract16 read = result[hw_x][hw_y] * UINT16_MAX;
-        Point os_xy = KeyGridRemap(Point(hw_x, hw_y));
+        Point os_xy = keyGridTable[hw_x][hw_y];
 
-        bool updated = keypadState[os_xy.x][os_xy.y].update(read);
+        bool updated = keypadState[os_xy.x][os_xy.y].update(keypad_config, read);
+        active |= keypadState[os_xy.x][os_xy.y].state != IDLE;
         if (updated)
         {
           uint16_t keyID = (1 << 12) + (os_xy.x << 6) + os_xy.y;
@@ -5,16 +5,19 @@ namespace Device
   namespace LED
   {
     void Init() {
-      WS2812::Init(RMT_CHANNEL_0, led_pin, led_chunk_count, led_chunk);
+      WS2812::Init(led_pin, led_partitions);
     }
 
     void Start() {}
 
-    void Update(Color* frameBuffer, uint8_t brightness)  // Render LED
+    bool Update(Color* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions)  // Render LED
     {
-      // ESP_LOGI("LED", "LED Update");
-      // ESP_LOGI("LED", "%d", frameBuffer[0].RGB());
-      WS2812::Show(frameBuffer, brightness);
+      return WS2812::Show(frameBuffer, brightness, dirtyPartitions);
+    }
+
+    bool Update(Color16* frameBuffer, vector<uint8_t>& brightness, uint32_t dirtyPartitions)
+    {
+      return WS2812::Show(frameBuffer, brightness, dirtyPartitions);
     }
 
     uint16_t XY2Index(Point xy) {
@@ -1,14 +1,10 @@
 #include "Device.h"
 #include "MatrixOS.h"
 #include "ui/UI.h"
+#include "esp_timer.h"
 
 namespace Device
 {
-  namespace KeyPad
-  {
-    void Scan();
-  }
-
   void DeviceInit() {
     // esp_timer_early_init();
     LoadDeviceInfo();
@@ -54,6 +50,10 @@ namespace Device
     // return 0;
   }
 
+  uint32_t Micros() {
+    return (uint32_t)esp_timer_get_time();
+  }
+
   void Log(string format, va_list valst) {
     // ESP_LOG_LEVEL((esp_log_level_t)level, tag.c_str(), format.c_str(), valst);
     // esp_log_writev(ESP_LOG_INFO, format.c_str(), valst);
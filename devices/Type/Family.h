@@ -58,8 +58,11 @@ namespace Device
     void StartKeyPad();
 
     // If return true, meaning the scan in interrupted
+    void Scan();
     bool ScanKeyPad();
 
+    void UpdateScanRate(bool active);  // Called after every keypad scan with whether any key is not idle
+
     bool NotifyOS(uint16_t keyID, KeyInfo* keyInfo);  // Passthrough MatrixOS::KeyPad::NewEvent() result
   }
 
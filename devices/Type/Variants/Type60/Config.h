@@ -36,6 +36,9 @@ namespace Device
 
   const uint16_t led_count = 79 + 40;
   inline uint16_t keypad_scanrate = 480;
+  inline uint16_t keypad_idle_scanrate = 120;   // 0 to never slow down
+  inline uint32_t keypad_idle_timeout = 10000;  // ms
+  inline uint16_t keypad_hold_scanrate = 0;     // 0 to stay at keypad_scanrate while held
   const uint8_t x_size = 15;
   const uint8_t y_size = 5;
 
@@ -65,8 +68,10 @@ namespace Device
   inline uint8_t brightness_level[8] = {8, 12, 24, 40, 64, 90, 120, 142};
 #define FINE_LED_BRIGHTNESS
   inline uint8_t fine_brightness_level[16] = {4, 8, 14, 20, 28, 38, 50, 64, 80, 98, 120, 142, 168, 198, 232, 255};
-  inline uint8_t led_chunk_count = 2;
-  inline ws2812_chunk led_chunk[2] = {{79, Color(0xFFFFFF), 1.0}, {40, Color(0xFFFFFF), 4}};
+  inline vector<LEDPartition> led_partitions = {
+      {"Keys", 1.0, 0, 79},
+      {"Underglow", 4.0, 79, 40},
+  };
 
   // Load Device config
   void LoadEVT1();
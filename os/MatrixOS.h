@@ -30,6 +30,7 @@ namespace MatrixOS
     void InitSysModules(void);
 
     uint32_t Millis(void);
+    uint32_t Micros(void);  // Wraps around every ~71 minutes, use for measuring short intervals
     void DelayMs(uint32_t intervalMs);
 
     void Reboot(void);
@@ -43,6 +44,31 @@ namespace MatrixOS
     void ExitAPP();
 
     void ErrorHandler(string error = string());
+
+    // Key to wire latency, only recorded with MATRIXOS_LATENCY_TRACE defined. Every stage is timed from the timestamp
+    // of the KeyEvent behind it. MIDI sent while handling a KeyEvent (until the next KEYPAD::Get() comes back empty)
+    // is traced back to that event.
+    enum ETraceStage : uint8_t {
+      TRACE_QUEUE,      // KEYPAD::NewEvent()
+      TRACE_DEQUEUE,    // KEYPAD::Get()
+      TRACE_MIDI_SEND,  // MIDI::Send()
+      TRACE_USB_TX,
+      TRACE_BLE_TX,
+      TRACE_UART_TX,
+      TRACE_STAGE_COUNT
+    };
+#define LATENCY_BUCKETS 16
+    struct LatencyHistogram {
+      uint32_t count;
+      uint32_t total_us;
+      uint32_t max_us;
+      uint32_t buckets[LATENCY_BUCKETS];  // Bucket n counts 2^n to 2^(n+1) - 1 us, the last one everything above
+    };
+    void TraceLatency(ETraceStage stage, uint32_t origin);
+    void SetTraceOrigin(uint32_t origin);
+    uint32_t GetTraceOrigin();
+    LatencyHistogram GetLatencyHistogram(ETraceStage stage);
+    void ResetLatencyHistograms();
   }
 
   namespace LED
@@ -57,16 +83,108 @@ namespace MatrixOS
     void SetColor(uint16_t ID, Color color, uint8_t layer = 255);
     void Fill(Color color, uint8_t layer = 255);
     void FillPartition(string partition, Color color, uint8_t layer = 255);
+    // Batched writes, layer check and rotation are resolved once per call. Writes to layer 0 show up as a single frame.
+    void SetColors(const Point* xy, const Color* colors, uint16_t count, uint8_t layer = 255);
+    void SetColors(const Point* xy, uint16_t count, Color color, uint8_t layer = 255);
+    void Blit(Point origin, Dimension size, const Color* source, uint8_t layer = 255);  // source is row major, size.x * size.y
+    void FillRect(Point origin, Dimension size, Color color, uint8_t layer = 255);
+    // Drawing primitives, clipped to the canvas and batched like the above. Spans on the grid are written straight into
+    // the layer buffer.
+    void DrawHLine(Point start, uint16_t length, Color color, uint8_t layer = 255);
+    void DrawVLine(Point start, uint16_t length, Color color, uint8_t layer = 255);
+    void DrawLine(Point start, Point end, Color color, uint8_t layer = 255);
+    void DrawRect(Point origin, Dimension size, Color color, uint8_t layer = 255);  // Outline only, FillRect to fill
+    void DrawCircle(Point center, uint8_t radius, Color color, bool fill = false, uint8_t layer = 255);
+    void BlitKeyed(Point origin, Dimension size, const Color* source, Color key, uint8_t layer = 255);  // key pixels are skipped
+    void BlitIndexed(Point origin, Dimension size, const uint8_t* source, const Color* palette, uint8_t layer = 255);
+    // Present the layer as one complete frame (tear free), never waits on the LED output. Update(0) presents the
+    // active layer as is, direct writes to layer 0 are otherwise shown on the next frame as they are.
     void Update(uint8_t layer = 255);
 
+    noexpose void UpdateIndexTable();  // Rebuild the XY to index table after rotation changed
+    noexpose void RotateCanvas(EDirection rotation);  // Switch to a new absolute rotation, keeping the content in place
+
     int8_t CurrentLayer();
     int8_t CreateLayer(uint16_t crossfade = crossfade_duration);
     void CopyLayer(uint8_t dest, uint8_t src);
+    // Update() composites every layer from 1 up to the updated layer. By default a layer is opaque and covers the
+    // layers below it, with a lower opacity, another blend mode or a transparent key the layers below show through.
+    void SetLayerBlend(uint8_t layer, uint8_t opacity, EBlendMode mode = BLEND_NORMAL);
+    void SetLayerTransparentKey(uint8_t layer, bool enable, Color key = Color(0));  // Pixels of this color are see through
     bool DestroyLayer(uint16_t crossfade = crossfade_duration);
 
     void Fade(uint16_t crossfade = crossfade_duration, Color* source_buffer = nullptr);
 
     void PauseUpdate(bool pause);
+
+    // Block until the LED output ticks, so an app renders exactly once per displayed frame. Return false on timeout
+    // (ex. the update is paused). Meant for the foreground app, only one task should wait on it at a time.
+    bool WaitForFrame(uint32_t timeout_ms = 100);
+
+    struct FrameTiming {
+      uint32_t count;
+      uint32_t total_us;  // Wraps around, reset the stats before measuring a long run
+      uint32_t max_us;
+    };
+    // Counters of the LED pipeline, always on. Compare requested and presented to tell an app publishing more frames
+    // than shown from a slow output (dropped) or a starved timer task (late).
+    struct FrameStats {
+      uint32_t frames;     // LED timer ticks
+      uint32_t dropped;    // Frames deferred because the output was still busy with the previous one
+      uint32_t late;       // Ticks that came in more than half a frame late
+      uint32_t requested;  // Frames published by Update()
+      uint32_t presented;  // Published frames picked up by the LED timer, the rest got replaced by a newer one first
+      uint32_t set_color_per_second;  // SetColor() calls over the last second, batched writes count every pixel
+      FrameTiming crossfade;  // Rendering crossfade frames
+      FrameTiming output;     // Device::LED::Update()
+      FrameTiming lock_wait;  // LED timer waiting on the active buffer lock
+    };
+    FrameStats GetFrameStats();
+    void ResetFrameStats();
+
+    struct BufferPoolStats {
+      uint8_t size;
+      uint8_t used;
+      uint8_t peak;
+      uint32_t allocations;
+    };
+    BufferPoolStats GetBufferPoolStats();  // Usage of the preallocated layer / crossfade buffer pool
+
+    // Effects played by the LED timer over a region of a layer, on top of the layer content, every frame. The app
+    // doesn't have to render or even Update() for them. Only the current (top) layer's animations are shown.
+    enum EAnimationEffect : uint8_t {
+      ANIMATION_BREATH,
+      ANIMATION_STROBE,
+      ANIMATION_SAW,
+      ANIMATION_TRIANGLE,
+      ANIMATION_RAINBOW,
+      ANIMATION_CROSSFADE,  // color to target over one period, then holds target
+      ANIMATION_KEYFRAMES,  // Interpolates between the keyframes, restarting every period
+    };
+
+    struct AnimationKeyframe {
+      uint16_t time;  // ms into the period, ascending
+      Color color;
+    };
+
+    struct Animation {
+      EAnimationEffect effect = ANIMATION_BREATH;
+      Color color;
+      Color target;            // ANIMATION_CROSSFADE
+      uint16_t period = 1000;
+      uint16_t repeat = 0;     // Periods to play, 0 for forever. Once done crossfade and keyframes hold their last color,
+                               // other effects stop and the layer shows through again
+      uint16_t delay = 0;      // ms each pixel starts after the previous step away from the region origin (x + y), for ripples
+      uint32_t start_time = 0; // Millis(), 0 for now
+      const AnimationKeyframe* keyframes = nullptr;  // Not copied, has to outlive the animation
+      uint8_t keyframe_count = 0;
+    };
+
+    // Return an id for StopAnimation(), -1 if all MAX_LED_ANIMATIONS are in use. Animations that stopped on their own
+    // free themselves, the rest go with StopAnimation() or their layer.
+    int32_t Animate(Point origin, Dimension size, const Animation& animation, uint8_t layer = 255);
+    void StopAnimation(int32_t id);
+    void StopAnimations(uint8_t layer = 255);
   }
 
   namespace KEYPAD
@@ -75,6 +193,8 @@ namespace MatrixOS
     uint16_t Scan();                    // Return # of changed key
     bool NewEvent(KeyEvent* keyevent);  // Adding keyevent, return true when queue is full
     bool Get(KeyEvent* keyEvent_dest, uint32_t timeout_ms = 0);
+    // Drain up to max_count events in one go, return how many were taken. Blocks up to timeout_ms for the first one.
+    uint16_t GetAll(KeyEvent* keyEvent_dest, uint16_t max_count, uint32_t timeout_ms = 0);
     KeyInfo* GetKey(Point keyXY);
     KeyInfo* GetKey(uint16_t keyID);
     void Clear();              // Don't handle any keyEvent till their next Press event (So no Release, Hold, etc)
@@ -84,6 +204,19 @@ namespace MatrixOS
     Point ID2XY(uint16_t keyID);  // Locate XY for given key ID, return Point(INT16_MIN, INT16_MIN) if no XY found for
                                   // given ID;
 
+    noexpose void UpdateKeyTable();  // Rebuild the XY / ID tables after rotation changed
+
+    // Counters of the KeyEvent queue, always on. Drops mean the app is not draining fast enough.
+    struct KeyEventStats {
+      uint32_t events;            // NewEvent() calls
+      uint32_t dropped;           // Events pushed out or not queued while full, releases excluded
+      uint32_t dropped_releases;  // Releases not queued, the ring was full with a release as its oldest event
+      uint32_t coalesced;         // Aftertouch and hold events skipped while (nearly) full
+      uint32_t peak;              // Most events queued at once
+      uint32_t queued;            // Events waiting right now
+    };
+    KeyEventStats GetKeyEventStats();
+    void ResetKeyEventStats();
   }
 
   namespace USB
@@ -1,5 +1,6 @@
 #include "Color.h"
 #include <cmath>
+#include <cstring>
 
 float fract(float x) { return x - int(x); }
 
@@ -68,10 +69,22 @@ uint8_t Color::scale8_video(uint8_t i, uint8_t scale) {
 }
 
 Color Color::HsvToRgb(float h, float s, float v) {
-  uint8_t r = int(255 * v * mix(1.0, constrain(std::abs(fract(h + 1.0) * 6.0 - 3.0) - 1.0, 0.0, 1.0), s));
-  uint8_t g = int(255 * v * mix(1.0, constrain(std::abs(fract(h + 0.6666666) * 6.0 - 3.0) - 1.0, 0.0, 1.0), s));
-  uint8_t b = int(255 * v * mix(1.0, constrain(std::abs(fract(h + 0.3333333) * 6.0 - 3.0) - 1.0, 0.0, 1.0), s));
-  return Color(r, g, b);
+  uint16_t hue = (uint32_t)(fract(h + 1.0f) * 65536);
+  return HsvToRgb(Fract16(hue), (uint8_t)(constrain(s, 0.0f, 1.0f) * 255), (uint8_t)(constrain(v, 0.0f, 1.0f) * 255));
+}
+
+// Same curve as the float version: v * mix(1, clamp(abs(fract(h + k) * 6 - 3) - 1), s), in 16.16 fixed point
+Color Color::HsvToRgb(Fract16 hue, uint8_t saturation, uint8_t value) {
+  const uint16_t offsets[3] = {0, 43691, 21845};  // R, G, B are a third of the wheel apart
+  uint8_t channels[3];
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    uint16_t h = hue.value + offsets[i];  // Wraps around like fract()
+    int32_t ramp = std::abs((int32_t)h * 6 - 3 * 65536) - 65536;
+    ramp = constrain(ramp, 0, 65536);
+    channels[i] = (uint32_t)value * (255UL * 65536 - saturation * (65536 - ramp)) / (255UL * 65536);
+  }
+  return Color(channels[0], channels[1], channels[2]);
 }
 
 void Color::RgbToHsv(Color rgb, float* h, float* s, float* v)
@@ -104,6 +117,29 @@ void Color::RgbToHsv(Color rgb, float* h, float* s, float* v)
   if (*h < 0)
     *h += 1.0;
 }
+void Color::RgbToHsv(Color rgb, Fract16* hue, uint8_t* saturation, uint8_t* value) {
+  uint8_t max = std::max(rgb.R, std::max(rgb.G, rgb.B));
+  uint8_t min = std::min(rgb.R, std::min(rgb.G, rgb.B));
+  int32_t delta = max - min;
+
+  *value = max;
+  *saturation = max ? delta * 255 / max : 0;
+  if (delta == 0)
+  {
+    *hue = 0;
+    return;
+  }
+
+  int32_t h;
+  if (rgb.R == max)
+    h = (rgb.G - rgb.B) * 65536 / (6 * delta); // between yellow & magenta
+  else if (rgb.G == max)
+    h = 65536 / 3 + (rgb.B - rgb.R) * 65536 / (6 * delta); // between cyan & yellow
+  else
+    h = 65536 * 2 / 3 + (rgb.R - rgb.G) * 65536 / (6 * delta); // between magenta & cyan
+  *hue = (uint16_t)h; // Negative wraps around the wheel
+}
+
 Color Color::Crossfade(Color color1, Color color2, Fract16 ratio) {
   uint8_t r = ratio.to8bits();
   uint8_t newR = (color1.R * (255 - r) + color2.R * r) >> 8;
@@ -111,3 +147,15 @@ Color Color::Crossfade(Color color1, Color color2, Fract16 ratio) {
   uint8_t newB = (color1.B * (255 - r) + color2.B * r) >> 8;
   return Color(newR, newG, newB);
 }
+
+bool Color::FromLegacy(const void* data, size_t size, Color* colors, uint16_t count) {
+  if (count == 0 || size != count * sizeof(Legacy))
+    return false;
+  for (uint16_t i = 0; i < count; i++)
+  {
+    Legacy legacy;
+    memcpy((void*)&legacy, (const uint8_t*)data + i * sizeof(Legacy), sizeof(Legacy));
+    colors[i] = FromLegacy(legacy);
+  }
+  return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Color.h"
+
+// 16 bit per channel color. Used by the render path where 8 bit math would band (crossfades, low brightness), the
+// output stage brings it down to 8 bit with temporal dithering.
+class Color16 {
+ public:
+  uint16_t R = 0;
+  uint16_t G = 0;
+  uint16_t B = 0;
+  uint16_t W = 0;
+
+  Color16() {}
+  Color16(uint16_t nR, uint16_t nG, uint16_t nB, uint16_t nW = 0) : R(nR), G(nG), B(nB), W(nW) {}
+  Color16(Color color) : R(color.R * 257), G(color.G * 257), B(color.B * 257), W(color.W * 257) {}
+
+  Color To8bits() { return Color(R >> 8, G >> 8, B >> 8, W >> 8); }
+
+  static uint16_t scale16(uint16_t i, uint16_t scale) { return ((uint32_t)i * (scale + 1)) >> 16; }
+
+  Color16 Scale(uint16_t scale) { return Color16(scale16(R, scale), scale16(G, scale), scale16(B, scale)); }
+
+  // Same as Color::Crossfade, but with the full 16 bit ratio. Steps from color1 towards color2 widened to 16 bit by a
+  // 15 bit weight, one multiply and a shift per channel instead of a division. Within 2 of the exact
+  // (c1 * (65535 - ratio) + c2 * ratio) / 255, and exact at both ends.
+  static Color16 Crossfade(Color color1, Color color2, Fract16 ratio) {
+    uint16_t r = (uint16_t)ratio;
+    int32_t weight = (r + (r >> 15)) >> 1;  // 0 - 32768
+    return Color16(color1.R * 257 + (((color2.R - color1.R) * 257 * weight) >> 15),
+                   color1.G * 257 + (((color2.G - color1.G) * 257 * weight) >> 15),
+                   color1.B * 257 + (((color2.B - color1.B) * 257 * weight) >> 15));
+  }
+
+  bool operator==(const Color16& color) const { return R == color.R && G == color.G && B == color.B && W == color.W; }
+  bool operator!=(const Color16& color) const { return !(*this == color); }
+};
+
+static_assert(sizeof(Color16) == 8, "Color16 must stay 8 bytes");
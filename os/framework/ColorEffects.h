@@ -1,25 +1,66 @@
 #pragma once
 
 #include "Color.h"
-#include <math.h>
 
 namespace MatrixOS::SYS
 {
     uint32_t Millis();
 }
 
+// Effects are integer only: time maps to a 16 bit phase (65536 is one period), sine comes from a quarter wave table
+// and hue from the integer Color::HsvToRgb. The span versions fill count pixels, each phase_step further along.
 namespace ColorEffects
 {
+    // sin() over the first quarter of a wave, 64 steps, scaled to 32767
+    const int16_t sine_quarter[65] = {0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956, 30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757, 32767};
+
+    // sin(2 * PI * phase / 65536) * 32767, linearly interpolated between table steps
+    inline int16_t Sine16(uint16_t phase)
+    {
+        uint8_t index = (phase >> 8) & 63;
+        uint8_t fraction = phase;
+        int32_t a, b;
+        if (phase & 0x4000) // Second and fourth quarter run the table backwards
+        {
+            a = sine_quarter[64 - index];
+            b = sine_quarter[63 - index];
+        }
+        else
+        {
+            a = sine_quarter[index];
+            b = sine_quarter[index + 1];
+        }
+        int16_t value = a + (((b - a) * fraction) >> 8);
+        return (phase & 0x8000) ? -value : value;
+    }
+
+    // (1 + sin) / 2 scaled to lowBound - 255
+    inline uint8_t Sine8(uint16_t phase, uint8_t lowBound = 0)
+    {
+        return ((int32_t)Sine16(phase) + 32767) * (255 - lowBound) / 65534 + lowBound;
+    }
+
+    // Where in the period the current time is, as a 16 bit phase
+    inline uint16_t Phase(uint16_t period, int32_t offset = 0)
+    {
+        return ((MatrixOS::SYS::Millis() - offset) % period) * 65536 / period;
+    }
+
     inline Color Rainbow(uint16_t period = 1000, int32_t offset = 0)
     {
-        float hue = ((MatrixOS::SYS::Millis() - offset) % period) / (float)period;
-        return Color::HsvToRgb(hue, 1.0, 1.0);
+        return Color::HsvToRgb(Fract16(Phase(period, offset)));
+    }
+
+    inline void Rainbow(Color* colors, uint16_t count, uint16_t phase_step, uint16_t period = 1000, int32_t offset = 0)
+    {
+        uint16_t phase = Phase(period, offset);
+        for (uint16_t i = 0; i < count; i++, phase += phase_step)
+        { colors[i] = Color::HsvToRgb(Fract16(phase)); }
     }
 
     inline uint8_t Breath(uint16_t period = 1000, int32_t offset = 0)
     {
-       float brightness = (1 + sin(2 * M_PI * (MatrixOS::SYS::Millis() - offset) / period)) / 2 * 255;
-       return (uint8_t)brightness;
+        return Sine8(Phase(period, offset));
     }
 
     inline Color ColorBreath(Color color, uint16_t period = 1000, int32_t offset = 0)
@@ -27,10 +68,16 @@ namespace ColorEffects
         return color.Scale(Breath(period, offset)).Gamma();
     }
 
+    inline void ColorBreath(Color* colors, uint16_t count, uint16_t phase_step, Color color, uint16_t period = 1000, int32_t offset = 0)
+    {
+        uint16_t phase = Phase(period, offset);
+        for (uint16_t i = 0; i < count; i++, phase += phase_step)
+        { colors[i] = color.Scale(Sine8(phase)).Gamma(); }
+    }
+
     inline uint8_t BreathLowBound(uint8_t lowBound = 32, uint16_t period = 1000, int32_t offset = 0)
     {
-       float brightness = (1 + sin(2 * M_PI * (MatrixOS::SYS::Millis() - offset) / period)) / 2 * (255 - lowBound) + lowBound;
-       return (uint8_t)brightness;
+        return Sine8(Phase(period, offset), lowBound);
     }
 
     inline Color ColorBreathLowBound(Color color, uint8_t lowBound = 64, uint16_t period = 1000, int32_t offset = 0)
@@ -38,6 +85,13 @@ namespace ColorEffects
         return color.Scale(BreathLowBound(lowBound, period, offset)).Gamma();
     }
 
+    inline void ColorBreathLowBound(Color* colors, uint16_t count, uint16_t phase_step, Color color, uint8_t lowBound = 64, uint16_t period = 1000, int32_t offset = 0)
+    {
+        uint16_t phase = Phase(period, offset);
+        for (uint16_t i = 0; i < count; i++, phase += phase_step)
+        { colors[i] = color.Scale(Sine8(phase, lowBound)).Gamma(); }
+    }
+
 
     inline uint8_t Strobe(uint16_t period = 1000, int32_t offset = 0)
     {
@@ -69,4 +123,4 @@ namespace ColorEffects
     {
         return color.Scale(Triangle(period, offset)).Gamma();
     }
-}
\ No newline at end of file
+}
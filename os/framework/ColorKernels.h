@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Color.h"
+#include <string.h>
+
+// Bulk color operations over whole buffers. Each 32 bit pixel word is split into its R/B and G/W byte pairs, so every
+// multiply works on two channels at once (SWAR). Results match the per pixel Color functions exactly.
+// Define COLOR_KERNELS_SCALAR to fall back to the per pixel Color functions.
+// BLEND_MULTIPLY has no word wide form (every channel has its own factor), BlendWord() doesn't take it.
+enum EBlendMode : uint8_t {
+  BLEND_NORMAL,
+  BLEND_ADD,       // Saturating add
+  BLEND_MULTIPLY,
+  BLEND_MAX,       // Lighten, per channel max
+};
+
+namespace ColorKernels
+{
+  const uint32_t EVEN_CHANNELS = 0x00FF00FF;  // R and B
+  const uint32_t RGB_CHANNELS = 0x00FFFFFF;
+
+  inline uint32_t Load(const Color& color) {
+    uint32_t word;
+    memcpy(&word, &color, sizeof(Color));
+    return word;
+  }
+
+  inline void Store(Color& color, uint32_t word) {
+    memcpy((void*)&color, &word, sizeof(Color));
+  }
+
+  // (a * (255 - ratio) + b * ratio) >> 8 on every channel, W is cleared (Same as Color::Crossfade)
+  inline uint32_t CrossfadeWord(uint32_t a, uint32_t b, uint8_t ratio) {
+    uint8_t inverse = 255 - ratio;
+    uint32_t even = (((a & EVEN_CHANNELS) * inverse + (b & EVEN_CHANNELS) * ratio) >> 8) & EVEN_CHANNELS;
+    uint32_t odd = (((a >> 8) & EVEN_CHANNELS) * inverse + ((b >> 8) & EVEN_CHANNELS) * ratio) & ~EVEN_CHANNELS;
+    return (even | odd) & RGB_CHANNELS;
+  }
+
+  // Blend source on top of dest, then mix the result over dest by opacity
+  inline uint32_t BlendWord(uint32_t dest, uint32_t source, EBlendMode mode, uint8_t opacity = 255) {
+    uint32_t blended = source;
+    switch (mode)
+    {
+      case BLEND_NORMAL:
+        break;
+      case BLEND_ADD:
+      {
+        uint32_t sum = (dest & 0x7F7F7F7F) + (source & 0x7F7F7F7F);
+        uint32_t overflow = ((dest & source) | (sum & (dest ^ source))) & 0x80808080;
+        blended = (sum ^ ((dest ^ source) & 0x80808080)) | ((overflow >> 7) * 0xFF);
+        break;
+      }
+      case BLEND_MAX:
+      {
+        // dest | 0x100 - source in every 9 bit lane, bit 8 stays set where dest >= source
+        uint32_t even = (((dest & EVEN_CHANNELS) | 0x01000100) - (source & EVEN_CHANNELS)) & 0x01000100;
+        uint32_t odd = ((((dest >> 8) & EVEN_CHANNELS) | 0x01000100) - ((source >> 8) & EVEN_CHANNELS)) & 0x01000100;
+        uint32_t mask = ((even >> 8) | odd) * 0xFF;
+        blended = (dest & mask) | (source & ~mask);
+        break;
+      }
+      default:
+        break;
+    }
+    if (opacity == 255)
+    { return blended; }
+    return CrossfadeWord(dest, blended, opacity);
+  }
+
+  inline void Fill(Color* dest, Color color, uint16_t count) {
+#ifdef COLOR_KERNELS_SCALAR
+    for (uint16_t i = 0; i < count; i++)
+    { dest[i] = color; }
+#else
+    uint32_t word = Load(color);
+    for (uint16_t i = 0; i < count; i++)
+    { Store(dest[i], word); }
+#endif
+  }
+
+  inline void Copy(Color* dest, const Color* source, uint16_t count) {
+    memcpy((void*)dest, (const void*)source, count * sizeof(Color));
+  }
+}
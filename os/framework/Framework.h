@@ -7,6 +7,7 @@
 #include "Direction.h"
 #include "Dimension.h"
 #include "Color.h"
+#include "Color16.h"
 #include "LogLevel.h"
 
 //Custom Data Struct
@@ -21,6 +22,7 @@
 #include "Utilts.h"
 #include "Hash.h"
 #include "ColorEffects.h"
+#include "ColorKernels.h"
 
 //OS Component
 #include "MidiPort.h"
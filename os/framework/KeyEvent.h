@@ -7,6 +7,7 @@
 #include "SavedVariable.h"
 #include "Types.h"
 #include "system/Parameters.h"
+#include "VelocityCurve.h"
 
 #define KEY_INFO_THRESHOLD 512
 // 1/127 - Key Velocity has to move beyond this range in order for after touch to be triggered
@@ -27,12 +28,52 @@ namespace MatrixOS::Logging
 }
 
 
+// Smoothing and rate limits for the aftertouch of a group of keys (ex. the whole keypad), shared through KeyConfig.
+// Aftertouch held back by a limit is not dropped, the key sends its latest pressure once the limit allows it, or right
+// before the release, so the last value always goes out.
+struct AftertouchLimit {
+  uint8_t smoothing = 0;      // One pole IIR on the pressure, moves 1 / 2^n of the way each scan. 0 for none
+  uint16_t key_interval = 0;  // Minimum ms between aftertouch events of one key, 0 for no limit
+  uint16_t rate = 0;          // Aftertouch events per second across all keys of the group, 0 for no limit
+  uint16_t burst = 16;        // Events the group can send at once after being quiet
+
+  uint32_t tokens = 0;  // In 1/1000 events
+  uint32_t lastRefill = 0;
+  uint32_t suppressed = 0;  // Aftertouch events held back
+  uint32_t flushed = 0;     // Held back pressure sent right before a release
+
+  bool Take(uint32_t timeNow) {
+    if (rate == 0)
+    { return true; }
+    uint32_t full = (uint32_t)burst * 1000;
+    uint32_t elapsed = timeNow - lastRefill;
+    lastRefill = timeNow;
+    tokens = elapsed >= full / rate ? full : tokens + elapsed * rate;  // Long quiet gaps would overflow the multiply
+    if (tokens > full)
+    { tokens = full; }
+    if (tokens < 1000)
+    { return false; }
+    tokens -= 1000;
+    return true;
+  }
+};
+
 struct KeyConfig {
   bool apply_curve;
   Fract16 low_threshold;
   Fract16 high_threshold;
   Fract16 activation_offset;
   uint16_t debounce;
+  uint32_t curve_scale = 0;  // UINT16_MAX / (high - low) in 16.16 from UpdateCurveScale(), 0 to divide every time
+  const VelocityCurve* velocity_curve = nullptr;  // nullptr for linear
+  AftertouchLimit* aftertouch = nullptr;           // nullptr for no smoothing and no limit
+
+  // Call after changing the thresholds
+  void UpdateCurveScale() {
+    uint16_t low = low_threshold;
+    uint16_t high = high_threshold;
+    curve_scale = high > low ? ((uint64_t)UINT16_MAX << 16) / (high - low) : 0;
+  }
 };
 
 enum KeyState : uint8_t { /*Status Keys*/ IDLE,
@@ -51,6 +92,10 @@ struct KeyInfo {
   Fract16 velocity = 0;
   bool hold = false;
   bool cleared = false;
+  bool aftertouchPending = false;   // Pressure moved but the aftertouch limit held the event back
+  bool aftertouchFlush = false;     // This AFTERTOUCH carries the held back pressure before a release, never coalesced
+  uint16_t pressure = 0;            // Smoothed velocity while activated
+  uint16_t lastAftertouchTime = 0;  // Millis(), truncated. Only used for intervals
 
   KeyInfo() {}
 
@@ -95,17 +140,57 @@ struct KeyInfo {
     }
     else
     {
-      uint32_t pre_division_velocity = ((uint16_t)velocity - (uint16_t)config.low_threshold) * UINT16_MAX;
-      velocity = (Fract16)(pre_division_velocity / ((uint16_t)config.high_threshold - (uint16_t)config.low_threshold));
+      uint32_t offset = (uint16_t)velocity - (uint16_t)config.low_threshold;
+      uint16_t linear;
+      if (config.curve_scale)
+      { linear = (uint64_t)offset * config.curve_scale >> 16; }
+      else
+      { linear = offset * UINT16_MAX / ((uint16_t)config.high_threshold - (uint16_t)config.low_threshold); }
+      velocity = config.velocity_curve ? config.velocity_curve->Map(linear) : linear;
       // MLOGD("Velocity Curve", "%d - %d", source, velocity);
     }
     return velocity;
   }
 
+  void resetAftertouch(uint32_t timeNow) {
+    pressure = velocity;
+    aftertouchPending = false;
+    lastAftertouchTime = timeNow;
+  }
+
+  Fract16 smoothPressure(KeyConfig& config, Fract16 new_velocity) {
+    if (config.aftertouch && config.aftertouch->smoothing)
+    {
+      int32_t step = ((int32_t)(uint16_t)new_velocity - pressure) >> config.aftertouch->smoothing;
+      pressure = step ? pressure + step : (uint16_t)new_velocity;  // Snap the last bit so it can still reach the ends
+    }
+    else
+    { pressure = new_velocity; }
+    return pressure;
+  }
+
+  // Checks the per key interval then the group rate, an aftertouch held back stays pending until one passes
+  bool aftertouchAllowed(KeyConfig& config, uint32_t timeNow) {
+    AftertouchLimit* limit = config.aftertouch;
+    if (limit == nullptr)
+    { return true; }
+    bool allowed = (limit->key_interval == 0 || (uint16_t)(timeNow - lastAftertouchTime) >= limit->key_interval) && limit->Take(timeNow);
+    if (!allowed)
+    {
+      if (!aftertouchPending)
+      { limit->suppressed++; }
+      aftertouchPending = true;
+      return false;
+    }
+    aftertouchPending = false;
+    lastAftertouchTime = timeNow;
+    return true;
+  }
+
   #define BELOW_VELOCITY_THRESHOLD new_velocity <=  config.low_threshold
   #define ABOVE_THRESHOLD new_velocity > config.low_threshold
   bool update(KeyConfig& config, Fract16 new_velocity) {
-    uint16_t timeNow = MatrixOS::SYS::Millis();
+    uint32_t timeNow = MatrixOS::SYS::Millis();
 
     switch (state)
     {
@@ -133,6 +218,7 @@ struct KeyInfo {
             // MatrixOS::Logging::LogVerbose("KeyInfo", "IDLE -> PRESSED");
             lastEventTime = timeNow;
             velocity = config.apply_curve ? applyVelocityCurve(config, new_velocity) : new_velocity;
+            resetAftertouch(timeNow);
             return true & !cleared;
           }
         }
@@ -151,6 +237,7 @@ struct KeyInfo {
           // MatrixOS::Logging::LogVerbose("KeyInfo", "DEBUNCING -> PRESSED");
           lastEventTime = timeNow;
           velocity = config.apply_curve ? applyVelocityCurve(config, new_velocity) : new_velocity;
+          resetAftertouch(timeNow);
           return true & !cleared; // I know just return "!cleared" works but I want to make it clear this is suppose to return true
         }
         return false;
@@ -173,12 +260,23 @@ struct KeyInfo {
       case HOLD:
       case AFTERTOUCH:
         state = ACTIVATED;
+        aftertouchFlush = false;
         // MatrixOS::Logging::LogVerbose("KeyInfo", "PRESSED/HOLD/AFTERTOUCH -> ACTIVATED");
         [[fallthrough]];
       case ACTIVATED:
       {
         if (BELOW_VELOCITY_THRESHOLD)
         {
+          if (aftertouchPending)  // Last pressure goes out first, the release follows on the next scan
+          {
+            state = AFTERTOUCH;
+            velocity = pressure;
+            aftertouchPending = false;
+            aftertouchFlush = true;
+            if (config.aftertouch)  // The limit may have been taken off while the key was held
+            { config.aftertouch->flushed++; }
+            return true & !cleared;
+          }
           if(config.debounce > 0)
           {
             state = RELEASE_DEBUNCING;
@@ -196,6 +294,7 @@ struct KeyInfo {
         }
         // Apply velocity Curve
         new_velocity = config.apply_curve ? applyVelocityCurve(config, new_velocity) : new_velocity;
+        new_velocity = smoothPressure(config, new_velocity);
 
         if (timeNow - lastEventTime > hold_threshold && !hold)
         {
@@ -203,15 +302,19 @@ struct KeyInfo {
           // MatrixOS::Logging::LogVerbose("KeyInfo", "ACTIVATED -> HOLD");
           velocity = new_velocity;
           hold = true;
+          aftertouchPending = false;
           return true & !cleared;
         }
-        else if(DIFFERENCE((uint16_t)new_velocity, (uint16_t)velocity) > KEY_INFO_THRESHOLD || ((new_velocity != velocity) && (uint16_t)new_velocity == UINT16_MAX))
+        else if(DIFFERENCE((uint16_t)new_velocity, (uint16_t)velocity) > KEY_INFO_THRESHOLD || ((new_velocity != velocity) && (uint16_t)new_velocity == UINT16_MAX) || (aftertouchPending && new_velocity != velocity))
         {
+          if (!aftertouchAllowed(config, timeNow))
+          { return false; }
           state = AFTERTOUCH;
           // MatrixOS::Logging::LogVerbose("KeyInfo", "ACTIVATED -> AFTERTOUCH");
           velocity = new_velocity;
           return true & !cleared;
         }
+        aftertouchPending = false;
         return false;
       }
     }
@@ -227,4 +330,5 @@ struct KeyInfo {
 struct KeyEvent {
   uint16_t id;
   KeyInfo info;
+  uint32_t timestamp = 0;  // SYS::Micros() when the key was scanned
 };
\ No newline at end of file
@@ -7,4 +7,5 @@ struct LEDPartition {
     float default_multiplier;
     uint16_t start;
     uint16_t size;
+    uint16_t fps = 0;  // Target refresh rate, 0 to refresh with every frame (Device::fps)
 };
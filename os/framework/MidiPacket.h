@@ -1,5 +1,6 @@
 #include <stdarg.h>
 #include "MidiSpecs.h"
+#include "system/Parameters.h"
 // #include "esp_log.h"
 
 enum EMidiStatus : uint8_t {
@@ -44,6 +45,9 @@ struct MidiPacket {
   uint16_t port = MIDI_PORT_INVALID;
   EMidiStatus status = None;
   uint8_t data[3] = {0, 0, 0};
+#ifdef MATRIXOS_LATENCY_TRACE
+  uint32_t origin = 0;  // KeyEvent timestamp this packet was sent for, 0 if none
+#endif
 
   MidiPacket() {}  // Place Holder data
 
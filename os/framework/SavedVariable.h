@@ -1,8 +1,10 @@
 #pragma once
 #include "Hash.h"
+#include "Color.h"
 
 namespace MatrixOS::NVS
 {
+  vector<char> GetVariable(uint32_t hash);
   int8_t GetVariable(uint32_t hash, void* pointer, uint16_t length);
   bool SetVariable(uint32_t hash, void* pointer, uint16_t length);
   bool DeleteVariable(uint32_t hash);
@@ -36,11 +38,23 @@ class SavedVariable {
   }
 
   bool Load() {
-    if (MatrixOS::NVS::GetVariable(hash, &value, sizeof(T)) == 0)
+    int8_t result = MatrixOS::NVS::GetVariable(hash, &value, sizeof(T));
+    if (result == 0)
     {
       state = SavedVariableState::Loaded;
       return true;
     }
+
+    if constexpr (std::is_same<T, Color>::value)
+    {
+      if (result == 2)  // Saved in the old Color layout, convert it and save it back
+      {
+        vector<char> data = MatrixOS::NVS::GetVariable(hash);
+        Color color;
+        if (Color::FromLegacy(data.data(), data.size(), &color, 1))
+        { return Set(color); }
+      }
+    }
     return false;
   }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstring>
 #include <array>
+#include <atomic>
 #include <deque>
 #include <forward_list>
 #include <list>
@@ -16,6 +17,7 @@
 #include <tuple>
 
 using std::array;
+using std::atomic;
 using std::deque;
 using std::forward_list;
 using std::list;
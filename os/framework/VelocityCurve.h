@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+#include "Fract16.h"
+
+// Shapes the linear velocity between the low and high threshold of a key. Built once into a table when the shape
+// changes, the scan only interpolates between two table points.
+enum EVelocityCurve : uint8_t {
+  VELOCITY_CURVE_LINEAR,
+  VELOCITY_CURVE_LOG,     // Louder on soft presses
+  VELOCITY_CURVE_EXP,     // Needs harder presses to get loud
+  VELOCITY_CURVE_CUSTOM,  // Straight lines between user points
+};
+
+struct VelocityCurvePoint {
+  Fract16 input;
+  Fract16 output;
+};
+
+#define VELOCITY_CURVE_STEPS 64
+
+struct VelocityCurve {
+  uint16_t table[VELOCITY_CURVE_STEPS + 1];
+
+  uint16_t Map(uint16_t linear) const {
+    uint8_t index = linear >> 10;
+    int32_t fraction = linear & 1023;
+    int32_t a = table[index];
+    int32_t b = table[index + 1];
+    return a + (((b - a) * fraction) >> 10);
+  }
+
+  void Build(EVelocityCurve shape) {
+    for (uint8_t i = 0; i <= VELOCITY_CURVE_STEPS; i++)
+    {
+      float x = (float)i / VELOCITY_CURVE_STEPS;
+      float y = x;
+      if (shape == VELOCITY_CURVE_LOG)
+      { y = logf(1 + 15 * x) / logf(16); }
+      else if (shape == VELOCITY_CURVE_EXP)
+      { y = (expf(3 * x) - 1) / (expf(3) - 1); }
+      table[i] = y * UINT16_MAX + 0.5f;
+    }
+  }
+
+  // Points have to be sorted by input, the curve holds flat before the first and after the last one
+  void Build(const VelocityCurvePoint* points, uint8_t count) {
+    if (count == 0)
+    {
+      Build(VELOCITY_CURVE_LINEAR);
+      return;
+    }
+    uint8_t point = 0;
+    for (uint8_t i = 0; i <= VELOCITY_CURVE_STEPS; i++)
+    {
+      uint32_t x = i * UINT16_MAX / VELOCITY_CURVE_STEPS;
+      while (point < count && x > points[point].input.value)
+      { point++; }
+      if (point == 0)
+      { table[i] = points[0].output.value; }
+      else if (point == count)
+      { table[i] = points[count - 1].output.value; }
+      else
+      {
+        const VelocityCurvePoint& from = points[point - 1];
+        const VelocityCurvePoint& to = points[point];
+        int32_t span = to.input.value - from.input.value;
+        table[i] = from.output.value + ((int64_t)to.output.value - from.output.value) * (int64_t)(x - from.input.value) / span;
+      }
+    }
+  }
+};
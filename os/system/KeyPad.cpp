@@ -3,31 +3,202 @@
 
 namespace MatrixOS::KEYPAD
 {
-  QueueHandle_t keyevent_queue;
+  // Single producer / single consumer ring. All the drivers call NewEvent() from the FreeRTOS timer task and the
+  // foreground app drains it, so head is only written by the producer. tail belongs to the consumer, except when the
+  // ring is full and the producer pushes the oldest event out. The consumer copies events out first and claims them
+  // with a CAS on tail after, so a copy that got overwritten by a drop is thrown away and taken again.
+  static_assert((KEYEVENT_QUEUE_SIZE & (KEYEVENT_QUEUE_SIZE - 1)) == 0, "KEYEVENT_QUEUE_SIZE has to be a power of 2");
+  const uint32_t KEYEVENT_QUEUE_MASK = KEYEVENT_QUEUE_SIZE - 1;
+  KeyEvent keyevents[KEYEVENT_QUEUE_SIZE];
+  atomic<uint32_t> keyeventHead = {0};  // Free running, index with & KEYEVENT_QUEUE_MASK
+  atomic<uint32_t> keyeventTail = {0};
+  SemaphoreHandle_t keyeventSemaphore;  // Given on every new event, wakes up Get() and GetAll() with a timeout
+  KeyEventStats keyeventStats = {};           // Only written by NewEvent()
+  atomic<bool> keyeventStatsReset = {false};  // Set by ResetKeyEventStats(), applied by NewEvent()
 
-  void Init() {
-    if (!keyevent_queue)
+  // Rotation aware lookup tables, rebuilt by UpdateKeyTable() when the rotation changes.
+  // ID to XY is a dense table for each key class, spanning the lowest to the highest index of that class that has a XY
+  struct KeyClassTable {
+    uint16_t start = 0;
+    vector<Point> points;
+  };
+  const int16_t idTableWidth = Device::x_size + 2;
+  const int16_t idTableHeight = Device::y_size + 2;
+  struct KeyTables {
+    // XY to ID covers the grid plus a 1 key border around it (ex. Touch Bar), anything outside falls back to the device
+    vector<uint16_t> ids;
+    KeyClassTable xy[16];
+  };
+  // XY2ID() and ID2XY() are called from any task, so a rotation builds the other set aside and publishes it whole. The
+  // set it replaces stays untouched until the next rotation.
+  KeyTables keyTables[2];
+  atomic<KeyTables*> activeKeyTables = {&keyTables[0]};
+
+  void UpdateKeyTable() {
+    EDirection rotation = UserVar::rotation;
+    Point dimension = Point(Device::x_size, Device::y_size);
+    KeyTables& tables = keyTables[activeKeyTables.load() == &keyTables[0]];
+
+    tables.ids.resize(idTableWidth * idTableHeight);
+    uint16_t classStart[16];
+    uint16_t classEnd[16] = {0};
+    std::fill(classStart, classStart + 16, UINT16_MAX);
+    for (int16_t y = -1; y < Device::y_size + 1; y++)
     {
-      keyevent_queue = xQueueCreate(KEYEVENT_QUEUE_SIZE, sizeof(KeyEvent));
+      for (int16_t x = -1; x < Device::x_size + 1; x++)
+      {
+        uint16_t keyID = Device::KeyPad::XY2ID(Point(x, y).Rotate(rotation, dimension));
+        tables.ids[(y + 1) * idTableWidth + (x + 1)] = keyID;
+        if (keyID == UINT16_MAX)
+        { continue; }
+        uint8_t keyClass = keyID >> 12;
+        uint16_t index = keyID & 0x0FFF;
+        classStart[keyClass] = std::min(classStart[keyClass], index);
+        classEnd[keyClass] = std::max(classEnd[keyClass], (uint16_t)(index + 1));
+      }
     }
-    else
+
+    for (uint8_t keyClass = 0; keyClass < 16; keyClass++)
     {
-      xQueueReset(keyevent_queue);
+      KeyClassTable& table = tables.xy[keyClass];
+      table.points.clear();
+      if (classStart[keyClass] == UINT16_MAX)
+      { continue; }
+      table.start = classStart[keyClass];
+      table.points.assign(classEnd[keyClass] - classStart[keyClass], Point::Invalid());
+      for (uint16_t index = classStart[keyClass]; index < classEnd[keyClass]; index++)
+      {
+        Point point = Device::KeyPad::ID2XY((keyClass << 12) + index);
+        if (point)
+        { point = point.Rotate(rotation, dimension, true); }
+        table.points[index - classStart[keyClass]] = point;
+      }
     }
+    activeKeyTables.store(&tables);
   }
 
+  void Init() {
+    UpdateKeyTable();
+
+    if (!keyeventSemaphore)
+    { keyeventSemaphore = xSemaphoreCreateBinary(); }
+    ClearList();
+  }
+
+  // Once the ring is down to its last KEYEVENT_QUEUE_RESERVE slots, an incoming aftertouch or hold is coalesced away:
+  // the key's latest state is still in GetKey() and the next aftertouch or release carries it. The reserve is left to
+  // presses, releases and the aftertouch flushed right before a release, as nothing comes after that one to carry its
+  // pressure. When full, the oldest event is pushed out unless it is a release, as a lost release leaves the key on in
+  // the app. The incoming event is dropped instead then.
+  const uint32_t KEYEVENT_QUEUE_RESERVE = KEYEVENT_QUEUE_SIZE / 4;
+
   bool NewEvent(KeyEvent* keyevent) {
+    uint32_t head = keyeventHead.load(std::memory_order_relaxed);
+    uint32_t tail = keyeventTail.load(std::memory_order_acquire);
+    KeyState state = keyevent->info.state;
+    if (keyeventStatsReset.exchange(false))
+    { keyeventStats = {}; }
+    keyeventStats.events++;
 
-    if (uxQueueSpacesAvailable(keyevent_queue) == 0)
+    if (head - tail >= KEYEVENT_QUEUE_SIZE - KEYEVENT_QUEUE_RESERVE && ((state == AFTERTOUCH && !keyevent->info.aftertouchFlush) || state == HOLD))
     {
-      // TODO: Drop first element
+      keyeventStats.coalesced++;
+      return false;  // Let the scan go on to the presses and releases the reserve is kept for
     }
-    xQueueSend(keyevent_queue, keyevent, 0);
-    return uxQueueSpacesAvailable(keyevent_queue) == 0;
+
+    if (head - tail >= KEYEVENT_QUEUE_SIZE)
+    {
+      // Only the producer writes the slots, so the oldest event can be looked at. Both the CAS failing and tail moving
+      // mean the consumer just took the oldest event, which makes the space all the same.
+      if (keyevents[tail & KEYEVENT_QUEUE_MASK].info.state != RELEASED)
+      {
+        if (keyeventTail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel))
+        {
+          keyeventStats.dropped++;
+          tail++;
+        }
+      }
+      else
+      {
+        uint32_t oldest = tail;
+        tail = keyeventTail.load(std::memory_order_acquire);
+        if (tail == oldest)
+        {
+          if (state == RELEASED)
+          { keyeventStats.dropped_releases++; }
+          else
+          { keyeventStats.dropped++; }
+          return true;
+        }
+      }
+    }
+
+    keyevents[head & KEYEVENT_QUEUE_MASK] = *keyevent;
+    keyeventHead.store(head + 1, std::memory_order_release);
+    xSemaphoreGive(keyeventSemaphore);
+#ifdef MATRIXOS_LATENCY_TRACE
+    SYS::TraceLatency(SYS::TRACE_QUEUE, keyevent->timestamp);
+#endif
+
+    uint32_t queued = head + 1 - tail;
+    if (queued > keyeventStats.peak)
+    { keyeventStats.peak = queued; }
+    return queued >= KEYEVENT_QUEUE_SIZE;
+  }
+
+  uint16_t Take(KeyEvent* keyevent_dest, uint16_t max_count) {
+    uint32_t tail = keyeventTail.load(std::memory_order_acquire);
+    while (true)
+    {
+      uint32_t count = std::min(keyeventHead.load(std::memory_order_acquire) - tail, (uint32_t)max_count);
+      if (count == 0)
+      { return 0; }
+      for (uint32_t i = 0; i < count; i++)
+      { keyevent_dest[i] = keyevents[(tail + i) & KEYEVENT_QUEUE_MASK]; }
+      // tail reloads on failure, the producer dropped events under the copy
+      if (keyeventTail.compare_exchange_weak(tail, tail + count, std::memory_order_acq_rel))
+      { return count; }
+    }
+  }
+
+#ifdef MATRIXOS_LATENCY_TRACE
+  uint16_t TraceTaken(KeyEvent* keyevent_dest, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++)
+    { SYS::TraceLatency(SYS::TRACE_DEQUEUE, keyevent_dest[i].timestamp); }
+    SYS::SetTraceOrigin(count ? keyevent_dest[count - 1].timestamp : 0);
+    return count;
+  }
+#else
+  inline uint16_t TraceTaken(KeyEvent*, uint16_t count) { return count; }
+#endif
+
+  uint16_t GetAll(KeyEvent* keyevent_dest, uint16_t max_count, uint32_t timeout_ms) {
+    uint16_t count = Take(keyevent_dest, max_count);
+    if (count || timeout_ms == 0 || max_count == 0)
+    { return TraceTaken(keyevent_dest, count); }
+
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+    TickType_t elapsed;
+    xSemaphoreTake(keyeventSemaphore, 0);  // Ignore a give for an event already taken
+    while ((count = Take(keyevent_dest, max_count)) == 0 && (elapsed = xTaskGetTickCount() - start) < timeout)
+    { xSemaphoreTake(keyeventSemaphore, timeout - elapsed); }
+    return TraceTaken(keyevent_dest, count);
   }
 
   bool Get(KeyEvent* keyevent_dest, uint32_t timeout_ms) {
-    return xQueueReceive(keyevent_queue, (void*)keyevent_dest, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+    return GetAll(keyevent_dest, 1, timeout_ms) == 1;
+  }
+
+  KeyEventStats GetKeyEventStats() {
+    KeyEventStats stats = keyeventStatsReset ? KeyEventStats{} : keyeventStats;
+    stats.queued = keyeventHead.load() - keyeventTail.load();
+    return stats;
+  }
+
+  // The scan may run on the other core, so the stats are cleared by the producer on its next event instead of here
+  void ResetKeyEventStats() {
+    keyeventStatsReset = true;
   }
 
   KeyInfo* GetKey(Point keyXY) {
@@ -44,14 +215,20 @@ namespace MatrixOS::KEYPAD
   }
 
   void ClearList() {
-    xQueueReset(keyevent_queue);
+    uint32_t tail = keyeventTail.load();
+    while (!keyeventTail.compare_exchange_weak(tail, keyeventHead.load()));
   }
 
   uint16_t XY2ID(Point xy)  // Not sure if this is required by Matrix OS, added in for now. return UINT16_MAX if no ID
-                            // is assigned to given XY //TODO Compensate for rotation
+                            // is assigned to given XY
   {
     if (!xy)
       return UINT16_MAX;
+    uint16_t tableX = xy.x + 1;
+    uint16_t tableY = xy.y + 1;
+    vector<uint16_t>& ids = activeKeyTables.load()->ids;
+    if (tableX < idTableWidth && tableY < idTableHeight)
+    { return ids[tableY * idTableWidth + tableX]; }
     xy = xy.Rotate(UserVar::rotation, Point(Device::x_size, Device::y_size));
     return Device::KeyPad::XY2ID(xy);
   }
@@ -59,6 +236,11 @@ namespace MatrixOS::KEYPAD
   Point ID2XY(uint16_t keyID)  // Locate XY for given key ID, return Point(INT16_MIN, INT16_MIN) if no XY found for
                                // given ID;
   {
+    KeyClassTable& table = activeKeyTables.load()->xy[keyID >> 12];
+    uint16_t offset = (keyID & 0x0FFF) - table.start;
+    if (offset < table.points.size() && table.points[offset])
+    { return table.points[offset]; }
+
     Point point = Device::KeyPad::ID2XY(keyID);
     if (point)
       return point.Rotate(UserVar::rotation, Point(Device::x_size, Device::y_size), true);
@@ -12,36 +12,563 @@ namespace MatrixOS::LED
   // Otherwise, render to layer 255 (Top layer). Content will be updated on the next Update();
   // If directly write to the active buffer, before NewLayer, CopyLayer(0, currentLayer) need to be called to resync the buffer.
 
+  // Dirty pixel bitmap for each layer except layer 0, 1 bit per LED. Marks the pixels changed since that layer was last
+  // synced into the active buffer by Update().
+  vector<vector<uint32_t>> dirtyMaps;
+  // How each layer is composited onto the layers below it. The default (opaque, normal, no key) fully covers them.
+  struct LayerBlend {
+    uint8_t opacity = 255;
+    EBlendMode mode = BLEND_NORMAL;
+    bool keyed = false;
+    Color key;
+  };
+  vector<LayerBlend> layerBlends;
+
+  uint8_t syncedLayer = 0; // Layer the active buffer is in sync with, 0 if the active buffer has been written directly
+
+  // Rotation aware XY to buffer index table. Covers the grid plus a 1 LED border around it (ex. Underglow), XY outside of
+  // it falls back to Device::LED::XY2Index.
+  vector<uint16_t> indexTable;
+  const int16_t indexTableWidth = Device::x_size + 2;
+  const int16_t indexTableHeight = Device::y_size + 2;
+  // The grid sits in the buffer as gridOrigin + x * gridStride.x + y * gridStride.y under the current rotation, so spans
+  // on it are drawn by stepping through the buffer. gridLinear is false on a device where it doesn't.
+  bool gridLinear = false;
+  int32_t gridOrigin = 0;
+  Point gridStride;
+
+  // Triple buffered presentation. Update() copies the finished frame into the back buffer and publishes it by swapping
+  // it with the ready buffer, the LED timer swaps a newly published ready buffer with the front buffer. Neither side ever
+  // waits on the other, and the timer always shows the latest complete frame.
+  Color* presentBuffers[3] = {nullptr, nullptr, nullptr};
+  uint8_t presentBack = 0;                   // Only touched by Update()
+  uint8_t presentFront = 1;                  // Only touched by the LED timer
+  atomic<uint8_t> presentReady = {2};        // PRESENT_NEW_FRAME is set when it holds a frame not yet shown
+  const uint8_t PRESENT_NEW_FRAME = 0x80;
+  Color* renderBuffer = nullptr;             // Copy of the frame last sent to the device, only touched by the LED timer
+  bool renderBufferStale = false;            // A 16 bit frame was sent after it, the next frame has to be sent in full
+
+  // Layer and crossfade buffers come from one slab allocated at boot, so opening and closing UIs never touches the heap.
+  // Sized for the worst case: layer 0 to MAX_LED_LAYERS, plus the crossfade source buffer.
+  const uint8_t frameBufferPoolSize = MAX_LED_LAYERS + 2;
+  Color* frameBufferPool = nullptr;
+  uint8_t frameBufferFreeList[frameBufferPoolSize]; // Stack of free slot indexes
+  uint8_t frameBufferFreeCount = 0;
+  uint8_t frameBufferPeakUsage = 0;
+  uint32_t frameBufferAllocations = 0;
+
+  // Frame pacing
+  SemaphoreHandle_t frameSemaphore;  // Given on every LED timer tick, see WaitForFrame()
+  uint32_t pendingPartitions = 0;    // Changed partitions not sent yet, the transport was busy or they weren't due
+  vector<uint8_t> partitionDividers; // LED timer ticks between refreshes of each partition, from LEDPartition::fps
+  uint32_t duePartitions = UINT32_MAX; // Partitions due for a refresh this tick
+  uint32_t frameTick = 0;
+  uint32_t lastFrameTime = 0;
+  FrameStats frameStats = {};              // Only written by the LED timer
+  atomic<bool> frameStatsReset = {false};  // Set by ResetFrameStats(), applied by the LED timer
+  uint32_t requestedFrames = 0;  // Written by Update(), kept out of frameStats as it is not touched by the LED timer
+  uint32_t setColorCalls = 0;    // Since the current one second window started, approximate if written from several tasks
+  uint32_t setColorWindowStart = 0;
+
+  // Animations, played over the frame by the LED timer into animationBuffer
+  struct AnimationSlot {
+    int32_t id = -1;  // -1 when free
+    uint8_t layer;
+    Point origin;
+    Dimension size;
+    Animation animation;
+  };
+  AnimationSlot animations[MAX_LED_ANIMATIONS];
+  int32_t nextAnimationId = 0;
+  Color* animationBuffer = nullptr;
+  Color* lastFrame = nullptr;   // Frame the LED timer last rendered, animations keep playing over it
+  bool animationShown = false;  // The frame last sent has animations in it
+
   vector<float> ledBrightnessMultiplier;
   vector<uint8_t> ledPartitionBrightness;
+  vector<uint8_t> renderedPartitionBrightness; // Brightness of the frame last sent to the device
 
-  bool needUpdate = false;
+  atomic<bool> needUpdate = {false};  // Layer 0 was written directly, the LED timer shows it as is
 
   bool crossfade_active = false;
   uint32_t crossfade_start_time = 0;
   uint16_t crossfade_duration = 0;
   Color* crossfade_source_buffer = nullptr;
   bool crossfade_destroy_source_buffer = false;
-  Color* crossfade_buffer = nullptr;
+  Color16* crossfade_buffer = nullptr; // Rendered at 16 bit so slow fades don't band, only touched by the LED timer
+  bool crossfade_rendered = false;
+  vector<uint32_t> crossfade_settled;  // 1 bit per LED, destination matched the source and crossfade_buffer already holds it
+
+  uint32_t RenderCrossfade(Color* destination);
 
-  void RenderCrossfade();
+  Color* AllocateFrameBuffer() {
+    Color* buffer = nullptr;
+    vTaskSuspendAll();
+    if (frameBufferFreeCount)
+    {
+      buffer = frameBufferPool + frameBufferFreeList[--frameBufferFreeCount] * Device::led_count;
+      frameBufferAllocations++;
+      if (frameBufferPoolSize - frameBufferFreeCount > frameBufferPeakUsage)
+      { frameBufferPeakUsage = frameBufferPoolSize - frameBufferFreeCount; }
+    }
+    xTaskResumeAll();
+    return buffer;
+  }
+
+  void FreeFrameBuffer(Color* buffer) {
+    if (buffer == nullptr)
+    { return; }
+    uint32_t slot = (buffer - frameBufferPool) / Device::led_count;
+    if (buffer < frameBufferPool || slot >= frameBufferPoolSize)
+    {
+      MatrixOS::SYS::ErrorHandler("Freeing led buffer not from the pool");
+      return;
+    }
+    vTaskSuspendAll();
+    bool alreadyFree = false;
+    for (uint8_t i = 0; i < frameBufferFreeCount && !alreadyFree; i++)
+    { alreadyFree = frameBufferFreeList[i] == slot; }
+    if (!alreadyFree)
+    {
+      frameBufferFreeList[frameBufferFreeCount++] = slot;
+      configASSERT(frameBufferFreeCount <= frameBufferPoolSize);
+    }
+    xTaskResumeAll();
+
+    if (alreadyFree)
+    { MLOGE("LED", "Led buffer %d freed twice", slot); }
+  }
+
+  // Give back the crossfade's own copy of the source, if it made one. Call with the buffer lock held.
+  void ReleaseCrossfadeSource() {
+    if (crossfade_destroy_source_buffer)
+    { FreeFrameBuffer(crossfade_source_buffer); }
+    crossfade_source_buffer = nullptr;
+    crossfade_destroy_source_buffer = false;
+  }
+
+  BufferPoolStats GetBufferPoolStats() {
+    BufferPoolStats stats;
+    stats.size = frameBufferPoolSize;
+    stats.used = frameBufferPoolSize - frameBufferFreeCount;
+    stats.peak = frameBufferPeakUsage;
+    stats.allocations = frameBufferAllocations;
+    return stats;
+  }
+
+  void BuildIndexTable(EDirection rotation, vector<uint16_t>& table) {
+    Point dimension = Point(Device::x_size, Device::y_size);
+    table.resize(indexTableWidth * indexTableHeight);
+    for (int16_t y = -1; y < Device::y_size + 1; y++)
+    {
+      for (int16_t x = -1; x < Device::x_size + 1; x++)
+      { table[(y + 1) * indexTableWidth + (x + 1)] = Device::LED::XY2Index(Point(x, y).Rotate(rotation, dimension)); }
+    }
+  }
+
+  void UpdateGridLayout() {
+    auto tableIndex = [](int16_t x, int16_t y) -> int32_t { return indexTable[(y + 1) * indexTableWidth + (x + 1)]; };
+    gridOrigin = tableIndex(0, 0);
+    gridStride = Point(Device::x_size > 1 ? tableIndex(1, 0) - gridOrigin : 0, Device::y_size > 1 ? tableIndex(0, 1) - gridOrigin : 0);
+    gridLinear = true;
+    for (int16_t y = 0; y < Device::y_size && gridLinear; y++)
+    {
+      for (int16_t x = 0; x < Device::x_size && gridLinear; x++)
+      { gridLinear = tableIndex(x, y) == gridOrigin + x * gridStride.x + y * gridStride.y; }
+    }
+  }
+
+  void UpdateIndexTable() {
+    BuildIndexTable(UserVar::rotation, indexTable);
+    UpdateGridLayout();
+  }
+
+  inline uint16_t XY2Index(Point xy) {
+    uint16_t tableX = xy.x + 1;
+    uint16_t tableY = xy.y + 1;
+    if (tableX < indexTableWidth && tableY < indexTableHeight)
+    { return indexTable[tableY * indexTableWidth + tableX]; }
+    return Device::LED::XY2Index(xy.Rotate(UserVar::rotation, Point(Device::x_size, Device::y_size)));
+  }
+
+  inline void MarkDirty(uint8_t layer, uint16_t index) {
+    if (layer == 0)
+    { return; } // The LED timer diffs the active buffer against the last frame sent instead
+    dirtyMaps[layer][index >> 5] |= 1UL << (index & 31);
+  }
+
+  void MarkAllDirty(uint8_t layer) {
+    std::fill(dirtyMaps[layer].begin(), dirtyMaps[layer].end(), UINT32_MAX);
+  }
+
+  void ClearDirty(uint8_t layer) {
+    std::fill(dirtyMaps[layer].begin(), dirtyMaps[layer].end(), 0);
+  }
+
+  inline void AddTiming(FrameTiming& timing, uint32_t start) {
+    uint32_t elapsed = MatrixOS::SYS::Micros() - start;
+    timing.count++;
+    timing.total_us += elapsed;
+    if (elapsed > timing.max_us)
+    { timing.max_us = elapsed; }
+  }
+
+  // Send the changed partitions that are due this tick. The rest, and any the device couldn't take because it was still
+  // busy, stay pending for a later tick.
+  template <typename Frame>
+  bool SendPartitions(Frame* frame, uint32_t dirtyPartitions) {
+    dirtyPartitions |= pendingPartitions;
+    uint32_t deferred = dirtyPartitions & ~duePartitions;
+    dirtyPartitions &= duePartitions;
+
+    uint32_t start = MatrixOS::SYS::Micros();
+    bool sent = Device::LED::Update(frame, ledPartitionBrightness, dirtyPartitions);
+    AddTiming(frameStats.output, start);
+    if (!sent)
+    {
+      if (dirtyPartitions)
+      { frameStats.dropped++; }
+      pendingPartitions = dirtyPartitions | deferred;
+      return false;
+    }
+    pendingPartitions = deferred;
+    renderedPartitionBrightness = ledPartitionBrightness;
+    return true;
+  }
+
+  void SendFrame(uint32_t dirtyPartitions) {
+    if (SendPartitions(renderBuffer, dirtyPartitions))
+    { renderBufferStale = false; }
+  }
+
+  // Copy the changed pixels of the frame into the render buffer and send the partitions that changed, either because
+  // one of their pixels or their brightness did, to the device.
+  void RenderFrame(Color* frame) {
+    uint32_t dirtyPartitions = 0;
+    for (uint8_t partition = 0; partition < Device::led_partitions.size(); partition++)
+    {
+      if (renderBufferStale || ledPartitionBrightness[partition] != renderedPartitionBrightness[partition])
+      { dirtyPartitions |= 1UL << partition; }
+
+      uint16_t end = Device::led_partitions[partition].start + Device::led_partitions[partition].size;
+      for (uint16_t index = Device::led_partitions[partition].start; index < end; index++)
+      {
+        if (renderBuffer[index] != frame[index])
+        {
+          renderBuffer[index] = frame[index];
+          dirtyPartitions |= 1UL << partition;
+        }
+      }
+    }
+    SendFrame(dirtyPartitions);
+  }
+
+  Color KeyframeColor(const Animation& animation, uint32_t time) {
+    const AnimationKeyframe* keyframes = animation.keyframes;
+    if (animation.keyframe_count == 0)
+    { return animation.color; }
+    if (time <= keyframes[0].time)
+    { return keyframes[0].color; }
+    for (uint8_t i = 1; i < animation.keyframe_count; i++)
+    {
+      if (time < keyframes[i].time)
+      {
+        uint16_t span = keyframes[i].time - keyframes[i - 1].time;
+        return Color::Crossfade(keyframes[i - 1].color, keyframes[i].color, Fract16((time - keyframes[i - 1].time) * 65535 / span));
+      }
+    }
+    return keyframes[animation.keyframe_count - 1].color;
+  }
+
+  // Color of an animation time ms after it started, return false once it is done and the layer should show through
+  bool AnimationColor(const Animation& animation, uint32_t time, Color* color) {
+    uint16_t period = animation.period ? animation.period : 1;
+    if (animation.effect == ANIMATION_CROSSFADE)
+    {
+      *color = time >= period ? animation.target : Color::Crossfade(animation.color, animation.target, Fract16(time * 65535 / period));
+      return true;
+    }
+
+    if (animation.repeat && time / period >= animation.repeat)
+    {
+      if (animation.effect != ANIMATION_KEYFRAMES)
+      { return false; }
+      *color = KeyframeColor(animation, period);
+      return true;
+    }
+
+    time %= period;
+    uint16_t phase = time * 65536 / period;
+    switch (animation.effect)
+    {
+      case ANIMATION_BREATH:
+        *color = Color(animation.color).Scale(ColorEffects::Sine8(phase)).Gamma();
+        break;
+      case ANIMATION_STROBE:
+        *color = phase < 0x8000 ? animation.color : Color(0);
+        break;
+      case ANIMATION_SAW:
+        *color = Color(animation.color).Scale(phase >> 8).Gamma();
+        break;
+      case ANIMATION_TRIANGLE:
+        *color = Color(animation.color).Scale(phase < 0x8000 ? phase >> 7 : (0xFFFF - phase) >> 7).Gamma();
+        break;
+      case ANIMATION_RAINBOW:
+        *color = Color::HsvToRgb(Fract16(phase));
+        break;
+      case ANIMATION_KEYFRAMES:
+        *color = KeyframeColor(animation, time);
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  // Return false once every pixel of the animation is done with
+  bool RenderAnimation(AnimationSlot& slot, uint32_t now) {
+    bool playing = false;
+    for (int16_t y = 0; y < slot.size.y; y++)
+    {
+      for (int16_t x = 0; x < slot.size.x; x++)
+      {
+        int32_t time = (int32_t)(now - slot.animation.start_time) - (x + y) * slot.animation.delay;
+        if (time < 0)
+        {
+          playing = true;
+          continue;
+        }
+        Color color;
+        if (!AnimationColor(slot.animation, time, &color))
+        { continue; }
+        playing = true;
+        uint16_t index = XY2Index(slot.origin + Point(x, y));
+        if (index != UINT16_MAX)
+        { animationBuffer[index] = color; }
+      }
+    }
+    return playing;
+  }
+
+  // Play the current layer's animations over the frame into animationBuffer. Return false if there are none.
+  bool RenderAnimations(Color* frame) {
+    uint32_t now = MatrixOS::SYS::Millis();
+    uint8_t layer = CurrentLayer();
+    bool rendered = false;
+    for (AnimationSlot& slot : animations)
+    {
+      if (slot.id < 0 || slot.layer != layer)
+      { continue; }
+      if (!rendered)
+      {
+        ColorKernels::Copy(animationBuffer, frame, Device::led_count);
+        rendered = true;
+      }
+      if (!RenderAnimation(slot, now))
+      { slot.id = -1; }
+    }
+    return rendered;
+  }
+
+  // buffer[index] = buffer[source[index]] for every index, in place by following each cycle of the permutation
+  template <typename Pixel>
+  void PermuteBuffer(Pixel* buffer, const vector<uint16_t>& source, vector<bool>& moved) {
+    moved.assign(source.size(), false);
+    for (uint16_t start = 0; start < source.size(); start++)
+    {
+      if (moved[start] || source[start] == UINT16_MAX || source[start] == start)
+      { continue; }
+      Pixel first = buffer[start];
+      uint16_t index = start;
+      while (source[index] != start)
+      {
+        buffer[index] = buffer[source[index]];
+        moved[index] = true;
+        index = source[index];
+      }
+      buffer[index] = first;
+      moved[index] = true;
+    }
+  }
+
+  // What was at an XY stays at that XY after the rotation, so apps don't have to redraw. Every layer, the presented
+  // frames and the crossfade buffers are moved along with the index table, while the LED timer is held off.
+  void RotateCanvas(EDirection rotation) {
+    vector<uint16_t> newTable;
+    BuildIndexTable(rotation, newTable);
+
+    // source[index] is where the pixel that ends up at index comes from. The table has to map the same set of LEDs
+    // under both rotations (a square grid and its underglow ring), otherwise there is nothing to rotate them into.
+    vector<uint16_t> source(Device::led_count, UINT16_MAX);
+    bool valid = true;
+    for (uint16_t i = 0; i < newTable.size(); i++)
+    {
+      uint16_t from = indexTable[i];
+      uint16_t to = newTable[i];
+      if (from == UINT16_MAX || to == UINT16_MAX)
+      {
+        valid &= from == to;
+        continue;
+      }
+      valid &= source[to] == UINT16_MAX;
+      source[to] = from;
+    }
+    for (uint16_t index = 0; index < Device::led_count && valid; index++)
+    { valid = source[index] == UINT16_MAX || source[source[index]] != UINT16_MAX; }
+
+    if (!valid)
+    { MLOGW("LED", "Rotation doesn't map the LEDs onto themselves, clearing the canvas"); }
+
+    vector<bool> moved;
+    xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
+    for (uint8_t layer = 0; layer < frameBuffers.size(); layer++)
+    {
+      if (valid)
+      { PermuteBuffer(frameBuffers[layer], source, moved); }
+      else
+      { ColorKernels::Fill(frameBuffers[layer], Color(0), Device::led_count); }
+      if (layer)
+      { MarkAllDirty(layer); }
+    }
+    for (uint8_t i = 0; i < 3; i++)
+    {
+      if (valid)
+      { PermuteBuffer(presentBuffers[i], source, moved); }
+      else
+      { ColorKernels::Fill(presentBuffers[i], Color(0), Device::led_count); }
+    }
+    if (valid && crossfade_active)
+    {
+      if (crossfade_destroy_source_buffer)  // Otherwise it is one of the layers
+      { PermuteBuffer(crossfade_source_buffer, source, moved); }
+      PermuteBuffer(crossfade_buffer, source, moved);
+      std::fill(crossfade_settled.begin(), crossfade_settled.end(), 0);  // Recheck every pixel
+    }
+    indexTable.swap(newTable);
+    UpdateGridLayout();
+    needUpdate = true;
+    xSemaphoreGive(activeBufferSemaphore);
+  }
 
   void LEDTimerCallback(TimerHandle_t xTimer) {
+    if (frameStatsReset.exchange(false))
+    { frameStats = {}; }
+    uint32_t now = MatrixOS::SYS::Micros();
+    if (frameStats.frames && now - lastFrameTime > (1000000 / Device::fps) * 3 / 2)
+    { frameStats.late++; }
+    lastFrameTime = now;
+    frameStats.frames++;
+
+    duePartitions = 0;
+    for (uint8_t partition = 0; partition < partitionDividers.size(); partition++)
+    {
+      if (frameTick % partitionDividers[partition] == 0)
+      { duePartitions |= 1UL << partition; }
+    }
+    frameTick++;
+
+    if (now - setColorWindowStart >= 1000000)
+    {
+      frameStats.set_color_per_second = setColorCalls;
+      setColorCalls = 0;
+      setColorWindowStart = now;
+    }
+
+    // The lock only covers the ready to front swap, the crossfade and the animation slots. The frame is sent after it
+    // is released, so Update() and the drawing calls never wait behind the LED driver.
+    uint32_t lockStart = MatrixOS::SYS::Micros();
     xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
-    if(crossfade_active)
+    AddTiming(frameStats.lock_wait, lockStart);
+
+    bool newFrame = presentReady.load() & PRESENT_NEW_FRAME;
+    if (newFrame)
+    {
+      presentFront = presentReady.exchange(presentFront) & ~PRESENT_NEW_FRAME;
+      frameStats.presented++;
+    }
+
+    bool realtime = needUpdate.exchange(false);
+
+    Color* frame = nullptr;
+    if (newFrame)
     {
-      RenderCrossfade();
+      frame = presentBuffers[presentFront];
+      // Layer 0 was written after the frame got published, show it on the next frame
+      if (realtime)
+      { needUpdate = true; }
     }
+    else if (realtime)
+    { frame = frameBuffers[0]; }
 
-    if (needUpdate)
+    if (frame)
+    { lastFrame = frame; }
+
+    uint32_t crossfadePartitions = 0;
+    bool crossfading = crossfade_active;
+    if (crossfading)
     {
-      // MLOGD("LED", "Update");
-      needUpdate = false;
+      uint32_t start = MatrixOS::SYS::Micros();
+      crossfadePartitions = RenderCrossfade(lastFrame ? lastFrame : frameBuffers[0]);
+      AddTiming(frameStats.crossfade, start);
 
-      // MLOGD("LED", "Update (Brightness size: %d)", ledPartitionBrightness.size());
-      Device::LED::Update(crossfade_active ? crossfade_buffer : frameBuffers[0], ledPartitionBrightness);
+      if (crossfade_active)
+      {
+        for (uint8_t partition = 0; partition < Device::led_partitions.size(); partition++)
+        {
+          if (ledPartitionBrightness[partition] != renderedPartitionBrightness[partition])
+          { crossfadePartitions |= 1UL << partition; }
+        }
+      }
+      else
+      {
+        crossfading = false;
+        frame = lastFrame;  // Crossfade done, the destination replaces the last 16 bit frame
+      }
+    }
+
+    if (!crossfading)
+    {
+      if (RenderAnimations(lastFrame))
+      {
+        frame = animationBuffer;
+        animationShown = true;
+      }
+      else if (animationShown)
+      {
+        frame = lastFrame;  // Clear what the last animations left behind
+        animationShown = false;
+      }
     }
     xSemaphoreGive(activeBufferSemaphore);
+
+    if (crossfading)
+    {
+      if (SendPartitions(crossfade_buffer, crossfadePartitions))
+      { renderBufferStale = true; }
+    }
+    else if (frame)
+    { RenderFrame(frame); }
+    else
+    { SendFrame(0); } // Nothing changed, let the driver keep dithering
+
+    xSemaphoreGive(frameSemaphore);
+  }
+
+  bool WaitForFrame(uint32_t timeout_ms) {
+    xSemaphoreTake(frameSemaphore, 0);  // Ignore a frame that ticked before the call
+    return xSemaphoreTake(frameSemaphore, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+  }
+
+  FrameStats GetFrameStats() {
+    FrameStats stats = frameStatsReset ? FrameStats{} : frameStats;
+    stats.requested = requestedFrames;
+    return stats;
+  }
+
+  // The LED timer may run on the other core, it clears its own stats on the next tick
+  void ResetFrameStats() {
+    frameStatsReset = true;
+    requestedFrames = 0;
   }
 
   void UpdateBrightness() {
@@ -64,37 +591,76 @@ namespace MatrixOS::LED
 
       // MLOGD("LED", "Partition %s Brightness %d (%d * %f = %f)", Device::led_partitions[i].name.c_str(), ledPartitionBrightness[i], MatrixOS::UserVar::brightness, ledBrightnessMultiplier[i], brightness_multiplied);
     }
+    needUpdate = true;
   }
 
   void Init() {
-    for (Color* buffer : frameBuffers)
+    if (frameBufferPool == nullptr)
     {
-      if(buffer)
+      frameBufferPool = (Color*)pvPortMalloc(frameBufferPoolSize * Device::led_count * sizeof(Color));
+      if (frameBufferPool == nullptr)
       {
-        vPortFree(buffer);
+        MatrixOS::SYS::ErrorHandler("Failed to allocate led buffer pool");
+        return;
       }
+      for (uint8_t slot = 0; slot < frameBufferPoolSize; slot++)
+      { frameBufferFreeList[frameBufferFreeCount++] = frameBufferPoolSize - 1 - slot; }
     }
 
+    for (Color* buffer : frameBuffers)
+    { FreeFrameBuffer(buffer); }
+
     frameBuffers.clear();
+    dirtyMaps.clear();
+    layerBlends.clear();
+    syncedLayer = 0;
+    for (AnimationSlot& slot : animations)
+    { slot.id = -1; }
+
+    if (renderBuffer == nullptr)
+    {
+      for (uint8_t i = 0; i < 3; i++)
+      { presentBuffers[i] = (Color*)pvPortMalloc(Device::led_count * sizeof(Color)); }
+      renderBuffer = (Color*)pvPortMalloc(Device::led_count * sizeof(Color));
+      crossfade_buffer = (Color16*)pvPortMalloc(Device::led_count * sizeof(Color16));
+      animationBuffer = (Color*)pvPortMalloc(Device::led_count * sizeof(Color));
+      if (renderBuffer == nullptr || crossfade_buffer == nullptr || animationBuffer == nullptr || presentBuffers[0] == nullptr || presentBuffers[1] == nullptr || presentBuffers[2] == nullptr)
+      {
+        MatrixOS::SYS::ErrorHandler("Failed to allocate led present buffer");
+        return;
+      }
+      std::fill(renderBuffer, renderBuffer + Device::led_count, Color(0));
+    }
     
     // Generate brightness level map
     ledBrightnessMultiplier.resize(Device::led_partitions.size());
     ledPartitionBrightness.resize(Device::led_partitions.size());
+    renderedPartitionBrightness.assign(Device::led_partitions.size(), 0);
+    partitionDividers.resize(Device::led_partitions.size());
     for (uint8_t i = 0; i < Device::led_partitions.size(); i++)
     {
       ledBrightnessMultiplier[i] = Device::led_partitions[i].default_multiplier;
       MatrixOS::NVS::GetVariable(Hash("system_led_brightness_multiplier_" + Device::led_partitions[i].name), &ledBrightnessMultiplier[i], sizeof(float));
+      uint16_t fps = Device::led_partitions[i].fps;
+      partitionDividers[i] = (fps == 0 || fps >= Device::fps) ? 1 : std::min((Device::fps + fps / 2) / fps, 255);
     }
 
     UpdateBrightness();
+    UpdateIndexTable();
 
     if(!activeBufferSemaphore)
     {
       activeBufferSemaphore = xSemaphoreCreateMutex();
     }
 
+    if(!frameSemaphore)
+    {
+      frameSemaphore = xSemaphoreCreateBinary();
+    }
+
     CreateLayer(0); //Create Layer 0 - The active layer
     CreateLayer(0); //Create Layer 1 - The base layer
+    lastFrame = frameBuffers[0];
 
     if(!led_tm)
     {
@@ -148,6 +714,7 @@ namespace MatrixOS::LED
   }
 
   void SetColor(Point xy, Color color, uint8_t layer) {
+    setColorCalls++;
     if (layer == 255)
     {
       layer = CurrentLayer();
@@ -159,19 +726,22 @@ namespace MatrixOS::LED
     }
 
     // MLOGV("LED", "Set Color #%.2X%.2X%.2X to %d %d at Layer %d", color.R, color.G, color.B, xy.x, xy.y, layer);
-    xy = xy.Rotate(UserVar::rotation, Point(Device::x_size, Device::y_size));
-    uint16_t index = Device::LED::XY2Index(xy);
+    uint16_t index = XY2Index(xy);
     if (index == UINT16_MAX)return;
+    if (frameBuffers[layer][index] == color) return;
 
     frameBuffers[layer][index] = color;
+    MarkDirty(layer, index);
 
     if(layer == 0)
     { 
+      syncedLayer = 0;
       needUpdate = true; 
     }
   }
 
   void SetColor(uint16_t ID, Color color, uint8_t layer) {
+    setColorCalls++;
     if (layer == 255)
     {
       layer = CurrentLayer();
@@ -184,11 +754,16 @@ namespace MatrixOS::LED
 
     uint16_t index = Device::LED::ID2Index(ID);
     if (index == UINT16_MAX) return;
+    if (frameBuffers[layer][index] == color) return;
       
     frameBuffers[layer][index] = color;
+    MarkDirty(layer, index);
 
     if(layer == 0)
-    { needUpdate = true; }
+    { 
+      syncedLayer = 0;
+      needUpdate = true; 
+    }
   }
 
   void Fill(Color color, uint8_t layer) {
@@ -206,13 +781,24 @@ namespace MatrixOS::LED
     uint16_t start = 0;
     uint16_t end = Device::led_count;
 
+    bool changed = false;
     for (uint16_t index = start; index < end; index++)
-    { frameBuffers[layer][index] = color; }
+    {
+      if (frameBuffers[layer][index] != color)
+      {
+        frameBuffers[layer][index] = color;
+        MarkDirty(layer, index);
+        changed = true;
+      }
+    }
 
     xTaskResumeAll();
 
-    if(layer == 0)
-    { needUpdate = true; }
+    if(layer == 0 && changed)
+    { 
+      syncedLayer = 0;
+      needUpdate = true; 
+    }
   }
 
   void FillPartition(string partition, Color color, uint8_t layer)
@@ -255,12 +841,277 @@ namespace MatrixOS::LED
       return;
     }
 
-    std::fill(frameBuffers[layer] + start, frameBuffers[layer] + end, color);
+    bool changed = false;
+    for (uint16_t index = start; index < end; index++)
+    {
+      if (frameBuffers[layer][index] != color)
+      {
+        frameBuffers[layer][index] = color;
+        MarkDirty(layer, index);
+        changed = true;
+      }
+    }
 
     xTaskResumeAll();
 
-    if(layer == 0)
-    { needUpdate = true; }
+    if(layer == 0 && changed)
+    { 
+      syncedLayer = 0;
+      needUpdate = true; 
+    }
+  }
+
+  bool ResolveLayer(uint8_t& layer) {
+    if (layer == 255)
+    { layer = CurrentLayer(); }
+    else if (layer >= frameBuffers.size() || frameBuffers[layer] == nullptr)
+    {
+      MatrixOS::SYS::ErrorHandler("LED Layer Unavailable");
+      return false;
+    }
+    return true;
+  }
+
+  // Batch writes to the active buffer hold the buffer lock so the LED timer never renders a half written batch
+  void BeginBatch(uint8_t layer) {
+    if (layer == 0)
+    { xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY); }
+  }
+
+  void EndBatch(uint8_t layer, bool changed) {
+    if (layer == 0)
+    {
+      if (changed)
+      {
+        syncedLayer = 0;
+        needUpdate = true;
+      }
+      xSemaphoreGive(activeBufferSemaphore);
+    }
+  }
+
+  inline bool WritePixel(uint8_t layer, uint16_t index, Color color) {
+    if (index == UINT16_MAX || frameBuffers[layer][index] == color)
+    { return false; }
+    frameBuffers[layer][index] = color;
+    MarkDirty(layer, index);
+    return true;
+  }
+
+  void SetColors(const Point* xy, const Color* colors, uint16_t count, uint8_t layer) {
+    if (!ResolveLayer(layer))
+    { return; }
+
+    bool changed = false;
+    setColorCalls += count;
+
+    BeginBatch(layer);
+    for (uint16_t i = 0; i < count; i++)
+    { changed |= WritePixel(layer, XY2Index(xy[i]), colors[i]); }
+    EndBatch(layer, changed);
+  }
+
+  void SetColors(const Point* xy, uint16_t count, Color color, uint8_t layer) {
+    if (!ResolveLayer(layer))
+    { return; }
+
+    bool changed = false;
+    setColorCalls += count;
+
+    BeginBatch(layer);
+    for (uint16_t i = 0; i < count; i++)
+    { changed |= WritePixel(layer, XY2Index(xy[i]), color); }
+    EndBatch(layer, changed);
+  }
+
+  inline bool Plot(uint8_t layer, Point xy, Color color) {
+    setColorCalls++;
+    return WritePixel(layer, XY2Index(xy), color);
+  }
+
+  // Range of i in [first, last] where position + i * step is within [0, size)
+  inline void ClipSpan(int16_t position, int16_t step, int16_t size, int16_t& first, int16_t& last) {
+    if (step == 0)
+    {
+      if (position < 0 || position >= size)
+      { last = first - 1; }
+      return;
+    }
+    first = std::max<int16_t>(first, step > 0 ? -position : position - size + 1);
+    last = std::min<int16_t>(last, step > 0 ? size - 1 - position : position);
+  }
+
+  // Write count pixels from start, moving by step (a unit step along x or y). The part of the span on the grid is written
+  // straight into the layer buffer with the grid stride, the rest (ex. Underglow) goes through XY2Index. source(i) gives
+  // the color of the i-th pixel, pixels of the key color are skipped when a key is given.
+  template <typename ColorSource>
+  bool WriteSpan(uint8_t layer, Point start, Point step, int16_t count, ColorSource source, const Color* key = nullptr) {
+    if (count <= 0)
+    { return false; }
+    int16_t first = 0;
+    int16_t last = count - 1;
+    if (gridLinear)
+    {
+      ClipSpan(start.x, step.x, Device::x_size, first, last);
+      ClipSpan(start.y, step.y, Device::y_size, first, last);
+    }
+    else
+    { last = -1; }
+
+    setColorCalls += count;
+    bool changed = false;
+    int16_t i = 0;
+    while (i < count)
+    {
+      if (i == first && first <= last)
+      {
+        Color* buffer = frameBuffers[layer];
+        Point xy = start + step * i;
+        uint16_t index = gridOrigin + xy.x * gridStride.x + xy.y * gridStride.y;
+        int16_t indexStep = step.x * gridStride.x + step.y * gridStride.y;
+        for (; i <= last; i++, index += indexStep)
+        {
+          Color color = source(i);
+          if ((key && color == *key) || buffer[index] == color)
+          { continue; }
+          buffer[index] = color;
+          MarkDirty(layer, index);
+          changed = true;
+        }
+        continue;
+      }
+      Color color = source(i);
+      if (!key || color != *key)
+      { changed |= WritePixel(layer, XY2Index(start + step * i), color); }
+      i++;
+    }
+    return changed;
+  }
+
+  // Resolve the layer and run draw (returning whether anything changed) as one batch
+  template <typename Draw>
+  void DrawBatch(uint8_t& layer, Draw draw) {
+    if (!ResolveLayer(layer))
+    { return; }
+    BeginBatch(layer);
+    bool changed = draw();
+    EndBatch(layer, changed);
+  }
+
+  template <typename ColorSource>
+  void WriteRect(Point origin, Dimension size, uint8_t layer, ColorSource source, const Color* key = nullptr) {
+    DrawBatch(layer, [&]() -> bool {
+      bool changed = false;
+      for (int16_t y = 0; y < size.y; y++)
+      { changed |= WriteSpan(layer, origin + Point(0, y), Point(1, 0), size.x, [&](int16_t x) -> Color { return source(x, y); }, key); }
+      return changed;
+    });
+  }
+
+  void Blit(Point origin, Dimension size, const Color* source, uint8_t layer) {
+    WriteRect(origin, size, layer, [&](int16_t x, int16_t y) -> Color { return source[y * size.x + x]; });
+  }
+
+  void BlitKeyed(Point origin, Dimension size, const Color* source, Color key, uint8_t layer) {
+    WriteRect(origin, size, layer, [&](int16_t x, int16_t y) -> Color { return source[y * size.x + x]; }, &key);
+  }
+
+  void BlitIndexed(Point origin, Dimension size, const uint8_t* source, const Color* palette, uint8_t layer) {
+    WriteRect(origin, size, layer, [&](int16_t x, int16_t y) -> Color { return palette[source[y * size.x + x]]; });
+  }
+
+  void FillRect(Point origin, Dimension size, Color color, uint8_t layer) {
+    WriteRect(origin, size, layer, [&](int16_t, int16_t) -> Color { return color; });
+  }
+
+  void DrawHLine(Point start, uint16_t length, Color color, uint8_t layer) {
+    DrawBatch(layer, [&]() -> bool { return WriteSpan(layer, start, Point(1, 0), length, [&](int16_t) -> Color { return color; }); });
+  }
+
+  void DrawVLine(Point start, uint16_t length, Color color, uint8_t layer) {
+    DrawBatch(layer, [&]() -> bool { return WriteSpan(layer, start, Point(0, 1), length, [&](int16_t) -> Color { return color; }); });
+  }
+
+  void DrawRect(Point origin, Dimension size, Color color, uint8_t layer) {
+    if (size.x <= 0 || size.y <= 0)
+    { return; }
+    DrawBatch(layer, [&]() -> bool {
+      auto fill = [&](int16_t) -> Color { return color; };
+      bool changed = WriteSpan(layer, origin, Point(1, 0), size.x, fill);
+      changed |= WriteSpan(layer, origin + Point(0, size.y - 1), Point(1, 0), size.x, fill);
+      changed |= WriteSpan(layer, origin + Point(0, 1), Point(0, 1), size.y - 2, fill);
+      changed |= WriteSpan(layer, origin + Point(size.x - 1, 1), Point(0, 1), size.y - 2, fill);
+      return changed;
+    });
+  }
+
+  void DrawLine(Point start, Point end, Color color, uint8_t layer) {
+    DrawBatch(layer, [&]() -> bool {
+      int16_t dx = std::abs(end.x - start.x);
+      int16_t dy = std::abs(end.y - start.y);
+      Point step = Point(end.x > start.x ? 1 : -1, end.y > start.y ? 1 : -1);
+      if (dx == 0 || dy == 0)  // Straight lines are spans
+      { return WriteSpan(layer, start, Point(dx ? step.x : 0, dy ? step.y : 0), std::max(dx, dy) + 1, [&](int16_t) -> Color { return color; }); }
+
+      // Bresenham
+      bool changed = false;
+      int16_t error = dx - dy;
+      Point xy = start;
+      while (true)
+      {
+        changed |= Plot(layer, xy, color);
+        if (xy == end)
+        { break; }
+        int16_t error2 = error * 2;
+        if (error2 > -dy)
+        {
+          error -= dy;
+          xy.x += step.x;
+        }
+        if (error2 < dx)
+        {
+          error += dx;
+          xy.y += step.y;
+        }
+      }
+      return changed;
+    });
+  }
+
+  void DrawCircle(Point center, uint8_t radius, Color color, bool fill, uint8_t layer) {
+    DrawBatch(layer, [&]() -> bool {
+      // Midpoint circle, every step covers the 8 octants
+      bool changed = false;
+      auto span = [&](int16_t x, int16_t y, int16_t length) { changed |= WriteSpan(layer, Point(x, y), Point(1, 0), length, [&](int16_t) -> Color { return color; }); };
+      int16_t x = radius;
+      int16_t y = 0;
+      int16_t error = 1 - radius;
+      while (x >= y)
+      {
+        if (fill)
+        {
+          span(center.x - x, center.y + y, x * 2 + 1);
+          span(center.x - x, center.y - y, x * 2 + 1);
+          span(center.x - y, center.y + x, y * 2 + 1);
+          span(center.x - y, center.y - x, y * 2 + 1);
+        }
+        else
+        {
+          const Point octants[8] = {Point(x, y), Point(-x, y), Point(x, -y), Point(-x, -y), Point(y, x), Point(-y, x), Point(y, -x), Point(-y, -x)};
+          for (const Point& octant : octants)
+          { changed |= Plot(layer, center + octant, color); }
+        }
+        y++;
+        if (error < 0)
+        { error += y * 2 + 1; }
+        else
+        {
+          x--;
+          error += (y - x) * 2 + 1;
+        }
+      }
+      return changed;
+    });
   }
 
    int8_t CurrentLayer() {
@@ -275,15 +1126,17 @@ namespace MatrixOS::LED
       MatrixOS::SYS::ErrorHandler("Max LED Layer Exceded");
       return -1;
     }
-    Color* frameBuffer = (Color*)pvPortMalloc(Device::led_count * sizeof(Color));
+    Color* frameBuffer = AllocateFrameBuffer();
     if (frameBuffer == nullptr)
     {
       MatrixOS::SYS::ErrorHandler("Failed to allocate new led buffer");
       return -1;
     }
     frameBuffers.push_back(frameBuffer);
+    dirtyMaps.push_back(vector<uint32_t>((Device::led_count + 31) / 32, 0));
+    layerBlends.push_back(LayerBlend());
     int8_t newLayer = CurrentLayer();
-    Fill(0, newLayer);
+    ColorKernels::Fill(frameBuffer, Color(0), Device::led_count);
     MLOGD("LED Layer", "Layer Created - %d", newLayer);
 
     if(crossfade)
@@ -304,8 +1157,13 @@ namespace MatrixOS::LED
         Fade(crossfade);
       }
 
-      vPortFree(frameBuffers.back());
+      StopAnimations(CurrentLayer());
+      FreeFrameBuffer(frameBuffers.back());
       frameBuffers.pop_back();
+      dirtyMaps.pop_back();
+      layerBlends.pop_back();
+      if (syncedLayer >= frameBuffers.size())
+      { syncedLayer = 0; }
       Update();
 
       MLOGD("LED Layer", "Layer Destoried - %d", frameBuffers.size());
@@ -318,6 +1176,7 @@ namespace MatrixOS::LED
         Fade(crossfade);
       }
       Fill(0, CurrentLayer());
+      StopAnimations(CurrentLayer());
       MLOGW("LED Layer", "Already at layer 1, can not delete layer");
       return false;
     }
@@ -327,9 +1186,127 @@ namespace MatrixOS::LED
   void CopyLayer(uint8_t dest, uint8_t src)
   {
     memcpy((void*)frameBuffers[dest], (void*)frameBuffers[src], Device::led_count * sizeof(Color));
+    MarkAllDirty(dest);
+    if (dest == 0)
+    {
+      syncedLayer = 0;
+      needUpdate = true;
+    }
+  }
+
+
+  // Publish the active buffer as a complete frame, the LED timer picks it up on its next tick. Called with the buffer lock held
+  void Present() {
+    memcpy((void*)presentBuffers[presentBack], (void*)frameBuffers[0], Device::led_count * sizeof(Color));
+    presentBack = presentReady.exchange(presentBack | PRESENT_NEW_FRAME) & ~PRESENT_NEW_FRAME;
+    requestedFrames++;
+  }
+
+  void SetLayerBlend(uint8_t layer, uint8_t opacity, EBlendMode mode) {
+    if (!ResolveLayer(layer) || layer == 0)
+    { return; }
+    layerBlends[layer].opacity = opacity;
+    layerBlends[layer].mode = mode;
+    MarkAllDirty(layer);
+  }
+
+  void SetLayerTransparentKey(uint8_t layer, bool enable, Color key) {
+    if (!ResolveLayer(layer) || layer == 0)
+    { return; }
+    layerBlends[layer].keyed = enable;
+    layerBlends[layer].key = key;
+    MarkAllDirty(layer);
+  }
+
+  int32_t Animate(Point origin, Dimension size, const Animation& animation, uint8_t layer) {
+    if (!ResolveLayer(layer))
+    { return -1; }
+
+    int32_t id = -1;
+    xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
+    for (AnimationSlot& slot : animations)
+    {
+      if (slot.id >= 0)
+      { continue; }
+      slot.layer = layer;
+      slot.origin = origin;
+      slot.size = size;
+      slot.animation = animation;
+      if (slot.animation.start_time == 0)
+      { slot.animation.start_time = MatrixOS::SYS::Millis(); }
+      slot.id = id = nextAnimationId++ & INT32_MAX;
+      break;
+    }
+    xSemaphoreGive(activeBufferSemaphore);
+
+    if (id < 0)
+    { MLOGW("LED", "No free animation slot"); }
+    return id;
+  }
+
+  void StopAnimation(int32_t id) {
+    if (id < 0)
+    { return; }
+    xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
+    for (AnimationSlot& slot : animations)
+    {
+      if (slot.id == id)
+      { slot.id = -1; }
+    }
+    xSemaphoreGive(activeBufferSemaphore);
+  }
+
+  void StopAnimations(uint8_t layer) {
+    if (layer == 255)
+    { layer = CurrentLayer(); }
+    xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
+    for (AnimationSlot& slot : animations)
+    {
+      if (slot.layer == layer)
+      { slot.id = -1; }
+    }
+    xSemaphoreGive(activeBufferSemaphore);
+  }
+
+  inline bool LayerCovers(uint8_t layer) {
+    return layerBlends[layer].opacity == 255 && layerBlends[layer].mode == BLEND_NORMAL && !layerBlends[layer].keyed;
+  }
+
+  // Per channel, a word wide multiply would need a factor per channel and ends up slower
+  inline Color Multiply(Color dest, Color source) {
+    return Color((dest.R * (source.R + 1)) >> 8, (dest.G * (source.G + 1)) >> 8, (dest.B * (source.B + 1)) >> 8,
+                 (dest.W * (source.W + 1)) >> 8);
   }
 
+  Color CompositePixel(uint8_t base, uint8_t top, uint16_t index) {
+    if (base == top && LayerCovers(top))
+    { return frameBuffers[top][index]; }
 
+    uint32_t pixel = 0;
+    for (uint8_t layer = base; layer <= top; layer++)
+    {
+      Color source = frameBuffers[layer][index];
+      if (layerBlends[layer].keyed && source == layerBlends[layer].key)
+      { continue; }
+      EBlendMode mode = layerBlends[layer].mode;
+      if (mode == BLEND_MULTIPLY)
+      {
+        Color dest;
+        ColorKernels::Store(dest, pixel);
+        source = Multiply(dest, source);
+        mode = BLEND_NORMAL;
+      }
+      pixel = ColorKernels::BlendWord(pixel, ColorKernels::Load(source), mode, layerBlends[layer].opacity);
+    }
+    Color color;
+    ColorKernels::Store(color, pixel);
+    return color;
+  }
+
+  // Layers 1 to the given layer are composited into the active buffer, starting from the highest layer that fully covers
+  // the ones below it. Only the pixels that changed in any of those layers since the last Update() are recomputed,
+  // unless the active buffer was last synced from another layer (or written to directly), in which case every pixel is.
+  // The result is then presented as one frame through presentReady, without taking any lock the LED timer holds.
   void Update(uint8_t layer)
   {
     if (layer == 255)
@@ -342,10 +1319,44 @@ namespace MatrixOS::LED
       return;
     }
 
-    xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
-    CopyLayer(0, layer);
-    needUpdate = true;
-    xSemaphoreGive(activeBufferSemaphore);
+    // Direct writes to the active buffer not shown yet are part of this frame
+    bool changed = needUpdate.exchange(false);
+
+    if (layer != 0)
+    {
+      uint8_t base = layer;
+      while (base > 1 && !LayerCovers(base))
+      { base--; }
+
+      bool fullSync = layer != syncedLayer;
+      Color* active = frameBuffers[0];
+      for (uint16_t word = 0; word < dirtyMaps[layer].size(); word++)
+      {
+        uint32_t bits = fullSync ? UINT32_MAX : 0;
+        for (uint8_t contributor = base; contributor <= layer && !fullSync; contributor++)
+        { bits |= dirtyMaps[contributor][word]; }
+
+        while (bits)
+        {
+          uint16_t index = word * 32 + __builtin_ctz(bits);
+          bits &= bits - 1;
+          if (index >= Device::led_count)
+          { break; }
+          Color pixel = CompositePixel(base, layer, index);
+          if (active[index] != pixel)
+          {
+            active[index] = pixel;
+            changed = true;
+          }
+        }
+      }
+      for (uint8_t contributor = base; contributor <= layer; contributor++)
+      { ClearDirty(contributor); }
+      syncedLayer = layer;
+    }
+
+    if (changed)
+    { Present(); }
   }
 
 
@@ -363,39 +1374,47 @@ namespace MatrixOS::LED
       return;
     }
 
+    // The LED timer renders and ends the crossfade under the buffer lock, so it can't free the source under us
+    xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
     if(crossfade_active)
     {
-      crossfade_active = false;
-      xSemaphoreTake(activeBufferSemaphore, portMAX_DELAY);
-    
       // Crossfade already active
       // MLOGW("LED", "Crossfade already active");
+      crossfade_active = false;
 
-      // If existing crossfade require to delete the source buffer, then delete it right now
-      if(crossfade_destroy_source_buffer) { vPortFree(crossfade_source_buffer); }
-
-      crossfade_source_buffer = crossfade_buffer; // Start crossfade from the crossfade buffer
-      crossfade_buffer = nullptr; // Let the RenderCrossfade() to create a new buffer
-      crossfade_destroy_source_buffer = true;
-      xSemaphoreGive(activeBufferSemaphore);
-
+      // Start crossfade from what the crossfade buffer shows right now. Before its first frame the screen still shows
+      // the current source, which is kept then.
+      if (crossfade_rendered)
+      {
+        ReleaseCrossfadeSource();
+        if ((crossfade_source_buffer = AllocateFrameBuffer()))
+        {
+          for (uint16_t index = 0; index < Device::led_count; index++)
+          { crossfade_source_buffer[index] = crossfade_buffer[index].To8bits(); }
+          crossfade_destroy_source_buffer = true;
+        }
+      }
+      crossfade_rendered = false;
     }
     else if(source_buffer == nullptr)
     {
       // Create a copy of the current buffer
-      crossfade_source_buffer = (Color*)pvPortMalloc(Device::led_count * sizeof(Color));
+      ReleaseCrossfadeSource();
+      crossfade_source_buffer = AllocateFrameBuffer();
       if(crossfade_source_buffer == nullptr)
       {
+        xSemaphoreGive(activeBufferSemaphore);
         MatrixOS::SYS::ErrorHandler("Failed to allocate crossfade buffer");
         return;
       }
-      memcpy((void*)crossfade_source_buffer, (void*)frameBuffers[0], Device::led_count * sizeof(Color));
+      ColorKernels::Copy(crossfade_source_buffer, frameBuffers[0], Device::led_count);
       crossfade_destroy_source_buffer = true;
     }
     else
     { 
       // This is used in the case of creating a new layer
       // No New buffer is created, the source buffer is used directly
+      ReleaseCrossfadeSource();
       crossfade_source_buffer = source_buffer;
       crossfade_destroy_source_buffer = false;
     }
@@ -403,20 +1422,16 @@ namespace MatrixOS::LED
     crossfade_start_time = MatrixOS::SYS::Millis() + crossfade_delay;
     crossfade_duration = crossfade;
     crossfade_active = true;
+    xSemaphoreGive(activeBufferSemaphore);
   }
 
   // If any layer is 0, it will be show up as black（or lightless)
   // If layer 2 is 255, it will be using the top layer
-  void RenderCrossfade() {
+  uint32_t RenderCrossfade(Color* destination) {
     Fract16 ratio = 0;
 
     uint32_t currentTime = MatrixOS::SYS::Millis();
 
-    if(crossfade_buffer == nullptr)
-    {
-      crossfade_buffer = (Color*)pvPortMalloc(Device::led_count * sizeof(Color));
-    }
-
     if(currentTime <= crossfade_start_time)
     {
       ratio = 0;
@@ -432,27 +1447,52 @@ namespace MatrixOS::LED
 
     // MLOGD("LED", "Crossfade %d %d %d", currentTime - crossfade_start_time, crossfade_duration, ratio);
 
+    uint32_t dirtyPartitions = 0;
     if(ratio < FRACT16_MAX)
     {
-      for (uint16_t index = 0; index < Device::led_count; index++)
+      // First frame of the fade, every pixel has to be written once
+      if (!crossfade_rendered)
       {
-        crossfade_buffer[index] = Color::Crossfade(
-              crossfade_source_buffer == nullptr ? Color(0) : crossfade_source_buffer[index], 
-              frameBuffers[0][index],
-              ratio
-            );
+        crossfade_settled.assign((Device::led_count + 31) / 32, 0);
+        dirtyPartitions = (1UL << Device::led_partitions.size()) - 1;
       }
+
+      // Only pixels where the destination differs from the source are blended. The others are written once and then
+      // skipped, until the destination changes under the fade (ex. live input), which is picked up here as it happens.
+      for (uint8_t partition = 0; partition < Device::led_partitions.size(); partition++)
+      {
+        uint16_t end = Device::led_partitions[partition].start + Device::led_partitions[partition].size;
+        for (uint16_t index = Device::led_partitions[partition].start; index < end; index++)
+        {
+          uint32_t& settled = crossfade_settled[index >> 5];
+          uint32_t bit = 1UL << (index & 31);
+          Color source = crossfade_source_buffer ? crossfade_source_buffer[index] : Color(0);
+          if (source == destination[index])
+          {
+            if (settled & bit)
+            { continue; }
+            crossfade_buffer[index] = Color16(source);
+            settled |= bit;
+          }
+          else
+          {
+            crossfade_buffer[index] = Color16::Crossfade(source, destination[index], ratio);
+            settled &= ~bit;
+          }
+          dirtyPartitions |= 1UL << partition;
+        }
+      }
+      crossfade_rendered = true;
     }
     else if(ratio == FRACT16_MAX)
     {
-      if(crossfade_destroy_source_buffer) { vPortFree(crossfade_source_buffer); }
-      vPortFree(crossfade_buffer);
-      crossfade_buffer = nullptr;
+      ReleaseCrossfadeSource();
+      crossfade_rendered = false;
       crossfade_active = false;
       // MLOGD("LED", "Crossfade Done");
     }
 
-    needUpdate = true;
+    return dirtyPartitions;
   }
 
   void PauseUpdate(bool pause) {
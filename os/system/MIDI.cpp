@@ -27,6 +27,11 @@ namespace MatrixOS::MIDI
   }
 
   bool Send(MidiPacket midiPacket, uint16_t timeout_ms) {
+#ifdef MATRIXOS_LATENCY_TRACE
+    if (midiPacket.origin == 0)
+    { midiPacket.origin = SYS::GetTraceOrigin(); }
+    SYS::TraceLatency(SYS::TRACE_MIDI_SEND, midiPacket.origin);
+#endif
     if (midiPacket.port == MIDI_PORT_EACH_CLASS)
     {
       uint16_t targetClass = MIDI_PORT_USB;
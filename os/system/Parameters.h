@@ -32,9 +32,12 @@
 #define MATRIXOS_LOG_USBCDC
 #define MATRIXOS_LOG_COLOR
 
+// #define MATRIXOS_LATENCY_TRACE  // Key to wire latency histograms, see SYS::GetLatencyHistogram()
+
 #define APPLICATION_STACK_SIZE (configMINIMAL_STACK_SIZE * 16)
 
-#define KEYEVENT_QUEUE_SIZE 16
+#define KEYEVENT_QUEUE_SIZE 64  // Power of 2
+#define MAX_LED_ANIMATIONS 32
 #define MIDI_QUEUE_SIZE 128
 
 inline const uint16_t hold_threshold = 400;
@@ -107,6 +107,51 @@ namespace MatrixOS::SYS
     return ((((uint64_t)xTaskGetTickCount()) * 1000) / configTICK_RATE_HZ);
   }
 
+  uint32_t Micros() {
+    return Device::Micros();
+  }
+
+  LatencyHistogram latencyHistograms[TRACE_STAGE_COUNT] = {};
+  std::atomic<uint32_t> latencyResetStages = {0};  // Bit per stage, cleared by the task tracing that stage
+  uint32_t traceOrigin = 0;
+
+  void TraceLatency(ETraceStage stage, uint32_t origin) {
+    if (origin == 0)
+    { return; }
+    uint32_t latency = Micros() - origin;
+    LatencyHistogram& histogram = latencyHistograms[stage];
+    if (latencyResetStages.load() & (1UL << stage))
+    {
+      latencyResetStages.fetch_and(~(1UL << stage));
+      histogram = {};
+    }
+    uint8_t bucket = 31 - __builtin_clz(latency | 1);
+    histogram.buckets[std::min(bucket, (uint8_t)(LATENCY_BUCKETS - 1))]++;
+    histogram.count++;
+    histogram.total_us += latency;
+    if (latency > histogram.max_us)
+    { histogram.max_us = latency; }
+  }
+
+  void SetTraceOrigin(uint32_t origin) {
+    traceOrigin = origin;
+  }
+
+  uint32_t GetTraceOrigin() {
+    return traceOrigin;
+  }
+
+  LatencyHistogram GetLatencyHistogram(ETraceStage stage) {
+    if (latencyResetStages.load() & (1UL << stage))
+    { return {}; }
+    return latencyHistograms[stage];
+  }
+
+  // Each stage is traced from a single task, possibly on the other core, which clears it on its next trace
+  void ResetLatencyHistograms() {
+    latencyResetStages = (1UL << TRACE_STAGE_COUNT) - 1;
+  }
+
   void DelayMs(uint32_t intervalMs) {
     vTaskDelay(pdMS_TO_TICKS(intervalMs));
   }
@@ -132,10 +177,10 @@ namespace MatrixOS::SYS
     {
       if (new_rotation == 0 && !absolute)
       { return; }
-      // LED::RotateCanvas(new_rotation); //TODO Does not work if absolute is true
-      for (uint8_t ledLayer = 0; ledLayer <= LED::CurrentLayer(); ledLayer++)
-      { LED::Fill(0, ledLayer); }
-      UserVar::rotation = (EDirection)((UserVar::rotation * !absolute + new_rotation) % 360);
+      EDirection rotation = (EDirection)((UserVar::rotation * !absolute + new_rotation) % 360);
+      LED::RotateCanvas(rotation);
+      UserVar::rotation = rotation;
+      KEYPAD::UpdateKeyTable();
     }
   }
 
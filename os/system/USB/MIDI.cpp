@@ -18,7 +18,12 @@ namespace MatrixOS::USB::MIDI
     while (true)
     {
       if (port.Get(&packet, portMAX_DELAY))
-      { tud_midi_stream_write(port.id % 0x100, packet.data, packet.Length()); }
+      {
+        tud_midi_stream_write(port.id % 0x100, packet.data, packet.Length());
+#ifdef MATRIXOS_LATENCY_TRACE
+        MatrixOS::SYS::TraceLatency(MatrixOS::SYS::TRACE_USB_TX, packet.origin);
+#endif
+      }
     }
   }
 
@@ -86,11 +86,13 @@ namespace MatrixOS::UIUtility
               }
 
               // Render the buffer to the LED screen
+              Color frame[Device::x_size * 8];
               for (uint8_t x = 0; x < Device::x_size; x++)
               {
                 for (uint8_t y = 0; y < 8; y++)
-                { MatrixOS::LED::SetColor(Point(x, y), buffer[x][y] ? color : Color(0)); }
+                { frame[y * Device::x_size + x] = buffer[x][y] ? color : Color(0); }
               }
+              MatrixOS::LED::Blit(Point(0, 0), Dimension(Device::x_size, 8), frame);
               MatrixOS::LED::Update();
 
               // Wait for the next frame
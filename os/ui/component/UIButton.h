@@ -54,15 +54,7 @@ class UIButton : public UIComponent {
 
 
   virtual bool Render(Point origin) {
-    Dimension dimension = GetSize();
-    Color color = GetColor();
-    for (uint16_t x = 0; x < dimension.x; x++)
-    {
-      for (uint16_t y = 0; y < dimension.y; y++)
-      {
-        MatrixOS::LED::SetColor(origin + Point(x, y), color);
-      }
-    }
+    MatrixOS::LED::FillRect(origin, GetSize(), GetColor());
     return true;
   }
 
@@ -1,6 +1,8 @@
 # For ESP32, sources in the Device/family.cmake and Variants/CmameLists.txt need to be modified.
 
 FREERTOS_SRC = lib/FreeRTOS-Kernel
+# Family can override this for ports outside of portable/GCC
+FREERTOS_PORT_PATH ?= $(FREERTOS_SRC)/portable/GCC/$(FREERTOS_PORT)
 
 # ---------------------------------------
 # Code Include
@@ -11,8 +13,9 @@ INC += \
 	devices \
 	lib/tinyusb/src \
 	lib/printf/src \
+	lib/cb0r/include \
 	$(FREERTOS_SRC)/include \
-	$(FREERTOS_SRC)/portable/GCC/$(FREERTOS_PORT) \
+	$(FREERTOS_PORT_PATH) \
 	. 
 
 # ---------------------------------------
@@ -26,24 +29,24 @@ SRC_CPP += $(wildcard applications/*.cpp applications/*/*.cpp applications/*/*/*
 
 # Library source
 SRC_C += \
-	lib\tinyusb\src\tusb.c \
-	lib\tinyusb\src\common\tusb_fifo.c \
-	lib\tinyusb\src\device\usbd.c \
-	lib\tinyusb\src\device\usbd_control.c \
-	lib\tinyusb\src\class\audio\audio_device.c \
-	lib\tinyusb\src\class\cdc\cdc_device.c \
-	lib\tinyusb\src\class\dfu\dfu_device.c \
-	lib\tinyusb\src\class\dfu\dfu_rt_device.c \
-	lib\tinyusb\src\class\hid\hid_device.c \
-	lib\tinyusb\src\class\midi\midi_device.c \
-	lib\tinyusb\src\class\msc\msc_device.c \
-	lib\tinyusb\src\class\net\ecm_rndis_device.c \
-	lib\tinyusb\src\class\net\ncm_device.c \
-	lib\tinyusb\src\class\usbtmc\usbtmc_device.c \
-	lib\tinyusb\src\class\video\video_device.c \
-	lib\tinyusb\src\class\vendor\vendor_device.c \
-	lib\printf\src\printf\printf.c \
-	lib\cb0r\src\cb0r.c
+	lib/tinyusb/src/tusb.c \
+	lib/tinyusb/src/common/tusb_fifo.c \
+	lib/tinyusb/src/device/usbd.c \
+	lib/tinyusb/src/device/usbd_control.c \
+	lib/tinyusb/src/class/audio/audio_device.c \
+	lib/tinyusb/src/class/cdc/cdc_device.c \
+	lib/tinyusb/src/class/dfu/dfu_device.c \
+	lib/tinyusb/src/class/dfu/dfu_rt_device.c \
+	lib/tinyusb/src/class/hid/hid_device.c \
+	lib/tinyusb/src/class/midi/midi_device.c \
+	lib/tinyusb/src/class/msc/msc_device.c \
+	lib/tinyusb/src/class/net/ecm_rndis_device.c \
+	lib/tinyusb/src/class/net/ncm_device.c \
+	lib/tinyusb/src/class/usbtmc/usbtmc_device.c \
+	lib/tinyusb/src/class/video/video_device.c \
+	lib/tinyusb/src/class/vendor/vendor_device.c \
+	lib/printf/src/printf/printf.c \
+	lib/cb0r/src/cb0r.c
 
 # Include all source C in family & device folder
 SRC_C += $(subst ,,$(wildcard $(DEVICE_PATH)/*.c))
@@ -60,6 +63,10 @@ SRC_C += \
 	$(FREERTOS_SRC)/tasks.c \
 	$(FREERTOS_SRC)/timers.c \
 	$(FREERTOS_SRC)/portable/MemMang/heap_4.c \
-	$(subst ,,$(wildcard $(FREERTOS_SRC)/portable/GCC/$(FREERTOS_PORT)/*.c))
+	$(subst ,,$(wildcard $(FREERTOS_PORT_PATH)/*.c))
+
+# Family can exclude sources that only build on its own hardware (SRC_EXCLUDE accepts make patterns)
+SRC_C := $(filter-out $(SRC_EXCLUDE),$(SRC_C))
+SRC_CPP := $(filter-out $(SRC_EXCLUDE),$(SRC_CPP))
 
 INC   += $(FAMILY_PATH)
\ No newline at end of file
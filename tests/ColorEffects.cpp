@@ -0,0 +1,117 @@
+#include "MatrixOS.h"
+#include "Test.h"
+#include "Fakes.h"
+#include <cmath>
+
+// The fixed point effects and HSV conversion against the float code they replaced
+
+float FloatFract(float x) { return x - int(x); }
+float FloatMix(float a, float b, float t) { return a + (b - a) * t; }
+float FloatClamp(float x) { return x < 0 ? 0 : (x > 1 ? 1 : x); }
+
+Color FloatHsvToRgb(float h, float s, float v) {
+  uint8_t r = int(255 * v * FloatMix(1.0f, FloatClamp(std::fabs(FloatFract(h + 1.0f) * 6.0f - 3.0f) - 1.0f), s));
+  uint8_t g = int(255 * v * FloatMix(1.0f, FloatClamp(std::fabs(FloatFract(h + 0.6666666f) * 6.0f - 3.0f) - 1.0f), s));
+  uint8_t b = int(255 * v * FloatMix(1.0f, FloatClamp(std::fabs(FloatFract(h + 0.3333333f) * 6.0f - 3.0f) - 1.0f), s));
+  return Color(r, g, b);
+}
+
+uint8_t FloatBreath(uint16_t period, int32_t offset, uint8_t lowBound = 0) {
+  float brightness = (1 + sinf(2 * (float)M_PI * (MatrixOS::SYS::Millis() - offset) / period)) / 2 * (255 - lowBound) + lowBound;
+  return (uint8_t)brightness;
+}
+
+uint8_t Distance(Color a, Color b) {
+  return std::max(abs(a.R - b.R), std::max(abs(a.G - b.G), abs(a.B - b.B)));
+}
+
+void TestHsvToRgb() {
+  uint8_t worst = 0;
+  for (uint32_t hue = 0; hue < 65536; hue += 16)
+  {
+    for (uint16_t saturation = 0; saturation < 256; saturation += 15)
+    {
+      for (uint16_t value = 0; value < 256; value += 15)
+      {
+        Color expected = FloatHsvToRgb(hue / 65536.0f, saturation / 255.0f, value / 255.0f);
+        worst = std::max(worst, Distance(Color::HsvToRgb(Fract16(hue), saturation, value), expected));
+        worst = std::max(worst, Distance(Color::HsvToRgb(hue / 65536.0f, saturation / 255.0f, value / 255.0f), expected));
+      }
+    }
+  }
+  printf("  HSV to RGB, worst error %d\n", worst);
+  CHECK(worst <= 1);
+}
+
+void TestRgbToHsv() {
+  uint8_t worst = 0;
+  for (uint32_t rgb = 0; rgb < 0x1000000; rgb += 0x010307)
+  {
+    Color color(rgb);
+    Fract16 hue;
+    uint8_t saturation, value;
+    Color::RgbToHsv(color, &hue, &saturation, &value);
+    worst = std::max(worst, Distance(Color::HsvToRgb(hue, saturation, value), color));
+  }
+  printf("  RGB to HSV to RGB, worst error %d\n", worst);
+  CHECK(worst <= 1);
+}
+
+void TestBreath() {
+  int16_t worst = 0;
+  int16_t worst_sine = 0;
+  for (uint16_t period : {1000, 777, 4000})
+  {
+    for (fake_millis = 1000; fake_millis < 1000 + period * 5u; fake_millis++)
+    {
+      worst = std::max<int16_t>(worst, abs(ColorEffects::Breath(period, 0) - FloatBreath(period, 0)));
+      worst = std::max<int16_t>(worst, abs(ColorEffects::Breath(period, 250) - FloatBreath(period, 250)));
+      worst = std::max<int16_t>(worst, abs(ColorEffects::BreathLowBound(64, period) - FloatBreath(period, 0, 64)));
+    }
+  }
+  for (uint32_t phase = 0; phase < 65536; phase++)
+  {
+    int16_t expected = lroundf(sinf(2 * (float)M_PI * phase / 65536) * 32767);
+    worst_sine = std::max<int16_t>(worst_sine, abs(ColorEffects::Sine16(phase) - expected));
+  }
+  printf("  Breath, worst error %d. Sine16, worst error %d / 32767\n", worst, worst_sine);
+  CHECK(worst <= 1);
+  CHECK(worst_sine <= 16);
+}
+
+void BenchmarkEffects() {
+  Color colors[Device::led_count];
+  uint16_t hue = 0;
+  printf("  Per call\n");
+  Benchmark("HSV to RGB, float", 200000, [&]() { benchmark_sink = FloatHsvToRgb((hue += 97) / 65536.0f, 1, 1).R; });
+  Benchmark("HSV to RGB, fixed point", 200000, [&]() { benchmark_sink = Color::HsvToRgb(Fract16(hue += 97)).R; });
+  Benchmark("Breath, float", 200000, [&]() {
+    fake_millis++;
+    benchmark_sink = FloatBreath(1000, 0);
+  });
+  Benchmark("Breath, fixed point", 200000, [&]() {
+    fake_millis++;
+    benchmark_sink = ColorEffects::Breath(1000, 0);
+  });
+
+  printf("  Rainbow over %d LEDs\n", Device::led_count);
+  Benchmark("float, per pixel", 20000, [&]() {
+    fake_millis++;
+    for (uint16_t i = 0; i < Device::led_count; i++)
+    { colors[i] = FloatHsvToRgb(FloatFract((fake_millis % 1000) / 1000.0f + i / 96.0f), 1, 1); }
+    benchmark_sink = colors[0].R;
+  });
+  Benchmark("fixed point, span", 20000, [&]() {
+    fake_millis++;
+    ColorEffects::Rainbow(colors, Device::led_count, 65536 / 96);
+    benchmark_sink = colors[0].R;
+  });
+}
+
+int main() {
+  TestHsvToRgb();
+  TestRgbToHsv();
+  TestBreath();
+  BenchmarkEffects();
+  return TestResult();
+}
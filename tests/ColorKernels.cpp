@@ -0,0 +1,134 @@
+#include "MatrixOS.h"
+#include "Test.h"
+#include <random>
+
+// The SWAR kernels against straightforward per channel versions, which are also what they get benchmarked against
+
+Color ScalarBlend(Color dest, Color source, EBlendMode mode, uint8_t opacity) {
+  uint8_t a[4] = {dest.R, dest.G, dest.B, dest.W};
+  uint8_t b[4] = {source.R, source.G, source.B, source.W};
+  uint8_t out[4];
+  for (uint8_t channel = 0; channel < 4; channel++)
+  {
+    switch (mode)
+    {
+      case BLEND_NORMAL: out[channel] = b[channel]; break;
+      case BLEND_ADD: out[channel] = a[channel] + b[channel] > 255 ? 255 : a[channel] + b[channel]; break;
+      case BLEND_MULTIPLY: out[channel] = (a[channel] * (b[channel] + 1)) >> 8; break;
+      case BLEND_MAX: out[channel] = a[channel] > b[channel] ? a[channel] : b[channel]; break;
+    }
+  }
+  Color blended(out[0], out[1], out[2], out[3]);
+  if (opacity == 255)
+  { return blended; }
+  return Color::Crossfade(dest, blended, Fract16(opacity, 8));
+}
+
+uint32_t Word(Color color) { return ColorKernels::Load(color); }
+
+Color FromWord(uint32_t word) {
+  Color color;
+  ColorKernels::Store(color, word);
+  return color;
+}
+
+std::mt19937 random_engine(1);
+Color RandomColor() { return FromWord(random_engine()); }
+
+void TestCrossfadeWord() {
+  for (uint32_t i = 0; i < 100000; i++)
+  {
+    Color a = RandomColor();
+    Color b = RandomColor();
+    uint8_t ratio = random_engine();
+    CHECK(FromWord(ColorKernels::CrossfadeWord(Word(a), Word(b), ratio)) == Color::Crossfade(a, b, Fract16(ratio, 8)));
+  }
+}
+
+// Multiply is done per channel by LED::CompositePixel, BlendWord() only has the word wide modes
+void TestBlendWord() {
+  const EBlendMode modes[] = {BLEND_NORMAL, BLEND_ADD, BLEND_MAX};
+  for (EBlendMode mode : modes)
+  {
+    // Every channel pair, on every channel at once
+    for (uint16_t a = 0; a < 256; a++)
+    {
+      for (uint16_t b = 0; b < 256; b++)
+      {
+        Color dest(a, b, a, b);
+        Color source(b, a, 255 - b, a);
+        CHECK(FromWord(ColorKernels::BlendWord(Word(dest), Word(source), mode)) == ScalarBlend(dest, source, mode, 255));
+      }
+    }
+
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+      Color dest = RandomColor();
+      Color source = RandomColor();
+      uint8_t opacity = random_engine();
+      CHECK(FromWord(ColorKernels::BlendWord(Word(dest), Word(source), mode, opacity)) == ScalarBlend(dest, source, mode, opacity));
+    }
+  }
+}
+
+void TestFill() {
+  Color buffer[Device::led_count + 1];
+  buffer[Device::led_count] = Color(1, 2, 3, 4);
+  ColorKernels::Fill(buffer, Color(10, 20, 30, 40), Device::led_count);
+  for (uint16_t i = 0; i < Device::led_count; i++)
+  { CHECK(buffer[i] == Color(10, 20, 30, 40)); }
+  CHECK(buffer[Device::led_count] == Color(1, 2, 3, 4));
+}
+
+// A frame's worth of two layer composites, what LED::Update does when everything is dirty
+void BenchmarkComposite() {
+  Color bottom[Device::led_count];
+  Color top[Device::led_count];
+  Color out[Device::led_count];
+  for (uint16_t i = 0; i < Device::led_count; i++)
+  {
+    bottom[i] = RandomColor();
+    top[i] = RandomColor();
+  }
+
+  const EBlendMode modes[] = {BLEND_NORMAL, BLEND_ADD, BLEND_MAX};
+  const char* names[] = {"normal", "add", "max"};
+  printf("  Compositing %d pixels\n", Device::led_count);
+  for (uint8_t m = 0; m < 3; m++)
+  {
+    for (uint8_t opacity : {(uint8_t)255, (uint8_t)128})
+    {
+      char name[64];
+      snprintf(name, sizeof(name), "%s %d scalar", names[m], opacity);
+      Benchmark(name, 20000, [&]() {
+        for (uint16_t i = 0; i < Device::led_count; i++)
+        { out[i] = ScalarBlend(bottom[i], top[i], modes[m], opacity); }
+        benchmark_sink = Word(out[Device::led_count - 1]);
+      });
+      snprintf(name, sizeof(name), "%s %d kernel", names[m], opacity);
+      Benchmark(name, 20000, [&]() {
+        for (uint16_t i = 0; i < Device::led_count; i++)
+        { ColorKernels::Store(out[i], ColorKernels::BlendWord(Word(bottom[i]), Word(top[i]), modes[m], opacity)); }
+        benchmark_sink = Word(out[Device::led_count - 1]);
+      });
+    }
+  }
+
+  Benchmark("fill scalar", 20000, [&]() {
+    for (uint16_t i = 0; i < Device::led_count; i++)
+    { out[i] = Color(benchmark_sink); }
+    benchmark_sink = Word(out[0]) + 1;
+  });
+  Benchmark("fill kernel", 20000, [&]() {
+    ColorKernels::Fill(out, Color(benchmark_sink), Device::led_count);
+    benchmark_sink = Word(out[0]) + 1;
+  });
+}
+
+int main() {
+  TestCrossfadeWord();
+  TestBlendWord();
+  TestFill();
+  BenchmarkComposite();
+  return TestResult();
+}
@@ -0,0 +1,101 @@
+#include "os/system/LED.cpp"
+#include "Test.h"
+#include "Fakes.h"
+#include <algorithm>
+
+// Crossfades take their source copy from the frame buffer pool, every one of them must go back exactly once
+
+using namespace MatrixOS::LED;
+
+uint8_t Used() { return GetBufferPoolStats().used; }
+
+void AdvanceFrame(uint32_t ms) {
+  fake_millis += ms;
+  LEDTimerCallback(nullptr);
+}
+
+void FinishCrossfade() {
+  AdvanceFrame(2000);
+  AdvanceFrame(16);
+  CHECK(!crossfade_active);
+  CHECK(crossfade_source_buffer == nullptr);
+  CHECK(!crossfade_destroy_source_buffer);
+}
+
+void TestFadeFromCopy(uint8_t baseline) {
+  Fade(200);
+  CHECK_EQ(Used(), baseline + 1);
+  AdvanceFrame(50);
+  CHECK(crossfade_active);
+  FinishCrossfade();
+  CHECK_EQ(Used(), baseline);
+}
+
+// A new fade while one runs replaces the source instead of leaking or freeing it twice
+void TestRestartFade(uint8_t baseline) {
+  Fade(200);
+  AdvanceFrame(50);
+  for (uint8_t i = 0; i < 5; i++)
+  {
+    Fade(200);
+    CHECK_EQ(Used(), baseline + 1);
+    AdvanceFrame(50);
+  }
+  // Restarted before the first frame got rendered, the original source is still what is shown and is kept
+  Fade(200);
+  Color* source = crossfade_source_buffer;
+  Fade(200);
+  CHECK(crossfade_source_buffer == source);
+  CHECK(crossfade_destroy_source_buffer);
+  CHECK_EQ(Used(), baseline + 1);
+  FinishCrossfade();
+  CHECK_EQ(Used(), baseline);
+}
+
+// Fading from a layer uses the layer itself, it must not be freed with the crossfade
+void TestFadeFromLayer(uint8_t baseline) {
+  CreateLayer(200);
+  CHECK_EQ(Used(), baseline + 1);
+  AdvanceFrame(50);
+  FinishCrossfade();
+  CHECK_EQ(Used(), baseline + 1);
+  DestroyLayer(200);
+  CHECK_EQ(Used(), baseline + 1);
+  FinishCrossfade();
+  CHECK_EQ(Used(), baseline);
+}
+
+void TestDoubleFree(uint8_t baseline) {
+  Color* buffer = AllocateFrameBuffer();
+  CHECK(buffer != nullptr);
+  FreeFrameBuffer(buffer);
+  FreeFrameBuffer(buffer);  // Rejected
+  CHECK_EQ(Used(), baseline);
+  CHECK(frameBufferFreeCount <= frameBufferPoolSize);
+
+  // Every slot can still be handed out once
+  vector<Color*> buffers;
+  while (Color* next = AllocateFrameBuffer())
+  { buffers.push_back(next); }
+  CHECK_EQ(buffers.size(), (size_t)(frameBufferPoolSize - baseline));
+  std::sort(buffers.begin(), buffers.end());
+  CHECK(std::adjacent_find(buffers.begin(), buffers.end()) == buffers.end());
+  for (Color* next : buffers)
+  { FreeFrameBuffer(next); }
+  CHECK_EQ(Used(), baseline);
+}
+
+int main() {
+  MatrixOS::UserVar::ui_animation.value = true;
+  Device::LED::Init();
+  Init();
+  fake_millis = 1000;
+  AdvanceFrame(16);
+
+  uint8_t baseline = Used();
+  TestFadeFromCopy(baseline);
+  TestRestartFade(baseline);
+  TestFadeFromLayer(baseline);
+  TestDoubleFree(baseline);
+  return TestResult();
+}
@@ -0,0 +1,147 @@
+#include "MatrixOS.h"
+#include "core/ESP32S3/WS2812/WS2812.cpp"
+#include "FakesESP.h"
+#include "Test.h"
+#include <cmath>
+#include <set>
+
+// How much banding the 16 bit crossfade and the dithered output stage take out, and what they cost per frame
+
+using namespace WS2812;
+
+// The exact 16 bit crossfade, three divisions per pixel
+Color16 DividingCrossfade(Color color1, Color color2, Fract16 ratio) {
+  uint32_t r = (uint16_t)ratio;
+  uint32_t inverse = FRACT16_MAX - r;
+  return Color16((color1.R * inverse + color2.R * r) / 255, (color1.G * inverse + color2.G * r) / 255,
+                 (color1.B * inverse + color2.B * r) / 255);
+}
+
+void TestCrossfade() {
+  for (uint16_t a = 0; a < 256; a++)
+  {
+    for (uint16_t b = 0; b < 256; b += 3)
+    {
+      Color from(a, b, 255 - a);
+      Color to(b, a, 255 - b);
+      CHECK(Color16::Crossfade(from, to, 0) == Color16(from));
+      CHECK(Color16::Crossfade(from, to, FRACT16_MAX) == Color16(to));
+      for (uint32_t ratio = 0; ratio <= FRACT16_MAX; ratio += 97)
+      {
+        Color16 fast = Color16::Crossfade(from, to, ratio);
+        Color16 exact = DividingCrossfade(from, to, ratio);
+        CHECK(abs(fast.R - exact.R) <= 2 && abs(fast.G - exact.G) <= 2 && abs(fast.B - exact.B) <= 2);
+      }
+    }
+  }
+}
+
+struct BandingResult {
+  double max_error;  // Worst distance of an LED's average output from its ideal value, in output steps
+  uint32_t levels;   // Distinct average outputs over the gradient
+};
+
+// Show a gradient between two close colors on the strip for frames frames at a low brightness, then compare each
+// LED's average output with the value it should have
+template <typename ColorType>
+BandingResult MeasureBanding(const vector<ColorType>& frame, const vector<double>& ideal, uint8_t brightness_value) {
+  const uint16_t frames = 256;
+  vector<uint8_t> brightness(Device::led_partitions.size(), brightness_value);
+  vector<double> sum(Device::led_count, 0);
+  vector<ColorType> buffer = frame;
+  for (uint16_t i = 0; i < frames; i++)
+  {
+    Show(buffer.data(), brightness);
+    for (uint16_t index = 0; index < Device::led_count; index++)
+    { sum[index] += led_data[index * 3 + 1]; }  // Red
+  }
+
+  BandingResult result = {0, 0};
+  std::set<long> levels;
+  for (uint16_t index = 0; index < Device::led_count; index++)
+  {
+    double average = sum[index] / frames;
+    result.max_error = std::max(result.max_error, std::fabs(average - ideal[index]));
+    levels.insert(lround(average * 100));
+  }
+  result.levels = levels.size();
+  return result;
+}
+
+void TestBanding() {
+  // A crossfade from red 80 to 96 frozen mid way, spread across the strip, at 1/4 brightness. The output sits around
+  // 20 - 24, above the dithering threshold.
+  const uint8_t brightness = 64;
+  vector<Color16> frame16(Device::led_count);
+  vector<Color> frame8(Device::led_count);
+  vector<double> ideal(Device::led_count);
+  for (uint16_t index = 0; index < Device::led_count; index++)
+  {
+    Fract16 ratio = index * FRACT16_MAX / (Device::led_count - 1);
+    frame16[index] = Color16::Crossfade(Color(80, 0, 0), Color(96, 0, 0), ratio);
+    frame8[index] = Color::Crossfade(Color(80, 0, 0), Color(96, 0, 0), ratio);
+    ideal[index] = frame16[index].R * (double)brightness / 65536 + 1;  // scale8_video keeps lit channels 1 up
+  }
+
+  dithering = false;
+  BandingResult eight_bit = MeasureBanding(frame8, ideal, brightness);
+  BandingResult sixteen_bit = MeasureBanding(frame16, ideal, brightness);
+  dithering = true;
+  BandingResult dithered = MeasureBanding(frame16, ideal, brightness);
+
+  printf("  Gradient over %d LEDs, worst error in output steps / distinct levels\n", Device::led_count);
+  printf("  %-40s %6.3f / %u\n", "8 bit crossfade", eight_bit.max_error, eight_bit.levels);
+  printf("  %-40s %6.3f / %u\n", "16 bit crossfade", sixteen_bit.max_error, sixteen_bit.levels);
+  printf("  %-40s %6.3f / %u\n", "16 bit crossfade, dithered", dithered.max_error, dithered.levels);
+
+  // Averaged over the frames the dithered output lands on the 16 bit value, without it every LED snaps to a step
+  CHECK(dithered.max_error < 0.02);
+  CHECK(sixteen_bit.max_error > 0.5);
+  CHECK(dithered.levels > eight_bit.levels * 4);
+}
+
+void BenchmarkFrame() {
+  vector<Color> from(Device::led_count);
+  vector<Color> to(Device::led_count);
+  for (uint16_t index = 0; index < Device::led_count; index++)
+  {
+    from[index] = Color(esp_random());
+    to[index] = Color(esp_random());
+  }
+  vector<Color16> buffer(Device::led_count);
+  vector<Color> buffer8(Device::led_count);
+  uint16_t ratio = 0;
+
+  printf("  One %d LED frame\n", Device::led_count);
+  Benchmark("crossfade, 16 bit dividing", 20000, [&]() {
+    ratio += 331;
+    for (uint16_t index = 0; index < Device::led_count; index++)
+    { buffer[index] = DividingCrossfade(from[index], to[index], ratio); }
+    benchmark_sink = buffer[0].R;
+  });
+  Benchmark("crossfade, 16 bit multiply shift", 20000, [&]() {
+    ratio += 331;
+    for (uint16_t index = 0; index < Device::led_count; index++)
+    { buffer[index] = Color16::Crossfade(from[index], to[index], ratio); }
+    benchmark_sink = buffer[0].R;
+  });
+  Benchmark("crossfade, 8 bit", 20000, [&]() {
+    ratio += 331;
+    for (uint16_t index = 0; index < Device::led_count; index++)
+    { buffer8[index] = Color::Crossfade(from[index], to[index], ratio); }
+    benchmark_sink = buffer8[0].R;
+  });
+
+  vector<uint8_t> brightness(Device::led_partitions.size(), 96);
+  dithering = true;
+  Benchmark("Show 8 bit, dithered", 20000, [&]() { Show(buffer8.data(), brightness); });
+  Benchmark("Show 16 bit, dithered", 20000, [&]() { Show(buffer.data(), brightness); });
+}
+
+int main() {
+  Init(0, Device::led_partitions);
+  TestCrossfade();
+  TestBanding();
+  BenchmarkFrame();
+  return TestResult();
+}
@@ -0,0 +1,133 @@
+#include "os/system/LED.cpp"
+#include "Test.h"
+
+// The span based drawing calls against the same shapes drawn a pixel at a time with SetColor
+
+using namespace MatrixOS::LED;
+
+const EDirection rotations[] = {UP, RIGHT, DOWN, LEFT};
+
+uint8_t fast;
+uint8_t reference;
+
+void Clear() {
+  ColorKernels::Fill(frameBuffers[fast], Color(0), Device::led_count);
+  ColorKernels::Fill(frameBuffers[reference], Color(0), Device::led_count);
+}
+
+bool Same() {
+  return std::equal(frameBuffers[fast], frameBuffers[fast] + Device::led_count, frameBuffers[reference]);
+}
+
+void SetColorRect(Point origin, Dimension size, Color color, uint8_t layer) {
+  for (int16_t y = 0; y < size.y; y++)
+  {
+    for (int16_t x = 0; x < size.x; x++)
+    { SetColor(origin + Point(x, y), color, layer); }
+  }
+}
+
+void TestShapes() {
+  Color color(0x123456);
+  // On the grid, over the underglow ring and clipped by every edge
+  const Point origins[] = {Point(0, 0), Point(2, 3), Point(-1, -1), Point(-3, 2), Point(5, -2), Point(6, 6), Point(-4, -4)};
+  const Dimension sizes[] = {Dimension(1, 1), Dimension(3, 2), Dimension(8, 8), Dimension(10, 10), Dimension(12, 1), Dimension(1, 12)};
+  for (Point origin : origins)
+  {
+    for (Dimension size : sizes)
+    {
+      Clear();
+      FillRect(origin, size, color, fast);
+      SetColorRect(origin, size, color, reference);
+      CHECK(Same());
+
+      Clear();
+      DrawRect(origin, size, color, fast);
+      SetColorRect(origin, Dimension(size.x, 1), color, reference);
+      SetColorRect(origin + Point(0, size.y - 1), Dimension(size.x, 1), color, reference);
+      SetColorRect(origin, Dimension(1, size.y), color, reference);
+      SetColorRect(origin + Point(size.x - 1, 0), Dimension(1, size.y), color, reference);
+      CHECK(Same());
+
+      Clear();
+      DrawHLine(origin, size.x, color, fast);
+      DrawVLine(origin, size.y, color, fast);
+      SetColorRect(origin, Dimension(size.x, 1), color, reference);
+      SetColorRect(origin, Dimension(1, size.y), color, reference);
+      CHECK(Same());
+
+      vector<Color> source(size.x * size.y);
+      for (uint16_t i = 0; i < source.size(); i++)
+      { source[i] = i % 3 ? Color(i * 7, i, 255 - i) : Color(0); }
+      Clear();
+      BlitKeyed(origin, size, source.data(), Color(0), fast);
+      for (int16_t y = 0; y < size.y; y++)
+      {
+        for (int16_t x = 0; x < size.x; x++)
+        {
+          if (source[y * size.x + x] != Color(0))
+          { SetColor(origin + Point(x, y), source[y * size.x + x], reference); }
+        }
+      }
+      CHECK(Same());
+    }
+  }
+
+  // Straight lines in both directions are spans, the others are plotted
+  Clear();
+  DrawLine(Point(6, 2), Point(-2, 2), color, fast);
+  DrawLine(Point(3, 9), Point(3, 0), color, fast);
+  SetColorRect(Point(-2, 2), Dimension(9, 1), color, reference);
+  SetColorRect(Point(3, 0), Dimension(1, 10), color, reference);
+  CHECK(Same());
+  Clear();
+  DrawLine(Point(0, 0), Point(7, 7), color, fast);
+  for (int16_t i = 0; i < 8; i++)
+  { SetColor(Point(i, i), color, reference); }
+  CHECK(Same());
+}
+
+void BenchmarkShapes() {
+  Color colors[2] = {Color(0xFF0000), Color(0x00FF00)};
+  uint8_t frame = 0;
+  Color source[Device::x_size * Device::y_size];
+  printf("  Full grid fill\n");
+  Benchmark("SetColor per pixel", 20000, [&]() { SetColorRect(Point(0, 0), Dimension(Device::x_size, Device::y_size), colors[frame++ & 1], reference); });
+  Benchmark("FillRect", 20000, [&]() { FillRect(Point(0, 0), Dimension(Device::x_size, Device::y_size), colors[frame++ & 1], fast); });
+  Benchmark("Blit", 20000, [&]() {
+    source[0] = colors[frame++ & 1];
+    Blit(Point(0, 0), Dimension(Device::x_size, Device::y_size), source, fast);
+  });
+  printf("  Row\n");
+  Benchmark("SetColor per pixel", 200000, [&]() { SetColorRect(Point(0, 3), Dimension(Device::x_size, 1), colors[frame++ & 1], reference); });
+  Benchmark("DrawHLine", 200000, [&]() { DrawHLine(Point(0, 3), Device::x_size, colors[frame++ & 1], fast); });
+  printf("  Column\n");
+  Benchmark("SetColor per pixel", 200000, [&]() { SetColorRect(Point(3, 0), Dimension(1, Device::y_size), colors[frame++ & 1], reference); });
+  Benchmark("DrawVLine", 200000, [&]() { DrawVLine(Point(3, 0), Device::y_size, colors[frame++ & 1], fast); });
+  printf("  Outline\n");
+  Benchmark("SetColor per pixel", 200000, [&]() {
+    Color color = colors[frame++ & 1];
+    SetColorRect(Point(0, 0), Dimension(Device::x_size, 1), color, reference);
+    SetColorRect(Point(0, Device::y_size - 1), Dimension(Device::x_size, 1), color, reference);
+    SetColorRect(Point(0, 1), Dimension(1, Device::y_size - 2), color, reference);
+    SetColorRect(Point(Device::x_size - 1, 1), Dimension(1, Device::y_size - 2), color, reference);
+  });
+  Benchmark("DrawRect", 200000, [&]() { DrawRect(Point(0, 0), Dimension(Device::x_size, Device::y_size), colors[frame++ & 1], fast); });
+}
+
+int main() {
+  Device::LED::Init();
+  Init();
+  reference = CreateLayer(0);
+  fast = CreateLayer(0);
+  for (EDirection rotation : rotations)
+  {
+    MatrixOS::UserVar::rotation.value = rotation;
+    UpdateIndexTable();
+    TestShapes();
+  }
+  MatrixOS::UserVar::rotation.value = UP;
+  UpdateIndexTable();
+  BenchmarkShapes();
+  return TestResult();
+}
@@ -0,0 +1,146 @@
+#include "MatrixOS.h"
+#include "Test.h"
+#include "Fakes.h"
+#include <algorithm>
+
+// A full KeyEvent ring gives up aftertouch, hold and presses, but never a queued release
+
+using namespace MatrixOS::KEYPAD;
+
+uint16_t nextID = 0;
+
+bool Push(KeyState state, uint16_t id = nextID++) {
+  KeyEvent keyevent;
+  keyevent.id = id;
+  keyevent.info.state = state;
+  return NewEvent(&keyevent);
+}
+
+vector<KeyEvent> Drain() {
+  vector<KeyEvent> keyevents(KEYEVENT_QUEUE_SIZE);
+  keyevents.resize(GetAll(keyevents.data(), keyevents.size()));
+  return keyevents;
+}
+
+uint16_t Count(const vector<KeyEvent>& keyevents, KeyState state) {
+  return std::count_if(keyevents.begin(), keyevents.end(), [&](const KeyEvent& keyevent) { return keyevent.info.state == state; });
+}
+
+// The reserve at the end of the ring only takes presses and releases
+void TestReserve() {
+  ResetKeyEventStats();
+  uint16_t reserve = KEYEVENT_QUEUE_SIZE / 4;
+  for (uint16_t i = 0; i < KEYEVENT_QUEUE_SIZE - reserve; i++)
+  { Push(AFTERTOUCH); }
+  // Coalesced, which doesn't stop the scan before the presses and releases of later keys
+  CHECK(!Push(AFTERTOUCH));
+  CHECK(!Push(HOLD));
+  for (uint16_t i = 0; i < reserve - 1; i++)
+  { CHECK(!Push(RELEASED)); }
+  CHECK(Push(PRESSED));
+
+  KeyEventStats stats = GetKeyEventStats();
+  CHECK_EQ(stats.coalesced, 2u);
+  CHECK_EQ(stats.dropped, 0u);
+  CHECK_EQ(stats.queued, (uint32_t)KEYEVENT_QUEUE_SIZE);
+  vector<KeyEvent> keyevents = Drain();
+  CHECK_EQ(Count(keyevents, AFTERTOUCH), KEYEVENT_QUEUE_SIZE - reserve);
+  CHECK_EQ(Count(keyevents, RELEASED), reserve - 1);
+  CHECK_EQ(Count(keyevents, HOLD), 0);
+}
+
+// Pushing out stops at the oldest release, every release queued is delivered in order
+void TestReleasesKept() {
+  ResetKeyEventStats();
+  nextID = 0;
+  for (uint16_t i = 0; i < KEYEVENT_QUEUE_SIZE; i++)
+  { Push(i % 2 ? RELEASED : PRESSED); }
+  // The oldest is a press and goes, then a release is the oldest and the incoming events go
+  Push(PRESSED);
+  Push(PRESSED);
+  Push(RELEASED);
+
+  KeyEventStats stats = GetKeyEventStats();
+  CHECK_EQ(stats.dropped, 2u);
+  CHECK_EQ(stats.dropped_releases, 1u);
+  vector<KeyEvent> keyevents = Drain();
+  CHECK_EQ(keyevents.size(), (size_t)KEYEVENT_QUEUE_SIZE);
+  CHECK_EQ(Count(keyevents, RELEASED), KEYEVENT_QUEUE_SIZE / 2);
+  for (uint16_t i = 1; i < keyevents.size(); i++)
+  { CHECK(keyevents[i].id > keyevents[i - 1].id); }
+  CHECK_EQ(keyevents.front().info.state, RELEASED);
+}
+
+// A full ring of presses and aftertouch drains in order with only the oldest events gone
+void TestPushOut() {
+  ResetKeyEventStats();
+  nextID = 0;
+  for (uint16_t i = 0; i < KEYEVENT_QUEUE_SIZE + 10; i++)
+  { Push(PRESSED); }
+  CHECK_EQ(GetKeyEventStats().dropped, 10u);
+  vector<KeyEvent> keyevents = Drain();
+  CHECK_EQ(keyevents.size(), (size_t)KEYEVENT_QUEUE_SIZE);
+  CHECK_EQ(keyevents.front().id, 10);
+  CHECK_EQ(keyevents.back().id, KEYEVENT_QUEUE_SIZE + 9);
+}
+
+// The pressure a key flushes right before its release has nothing after it to carry it, it gets the reserve too
+void TestFlushedAftertouchKept() {
+  ResetKeyEventStats();
+  AftertouchLimit limit = {.smoothing = 0, .key_interval = 1000};
+  KeyConfig config = {.apply_curve = false, .low_threshold = 1000, .high_threshold = 60000, .activation_offset = 0, .debounce = 0, .aftertouch = &limit};
+  KeyInfo key;
+  fake_millis = 10000;
+  CHECK(key.update(config, 20000));  // Pressed
+  CHECK_EQ(key.state, PRESSED);
+  key.update(config, 20000);
+  CHECK(!key.update(config, 40000));  // Within the key interval, held back
+  CHECK(key.aftertouchPending);
+  CHECK(key.update(config, 0));  // Flushed
+  CHECK_EQ(key.state, AFTERTOUCH);
+  CHECK(key.aftertouchFlush);
+
+  for (uint16_t i = 0; i < KEYEVENT_QUEUE_SIZE * 3 / 4; i++)
+  { Push(AFTERTOUCH); }
+  KeyEvent flush = {.id = 1000, .info = key};
+  NewEvent(&flush);
+  CHECK(key.update(config, 0));  // Released
+  CHECK_EQ(key.state, RELEASED);
+  CHECK(!key.aftertouchFlush);
+  KeyEvent release = {.id = 1000, .info = key};
+  NewEvent(&release);
+
+  CHECK_EQ(GetKeyEventStats().coalesced, 0u);
+  vector<KeyEvent> keyevents = Drain();
+  CHECK_EQ(keyevents.size(), (size_t)KEYEVENT_QUEUE_SIZE * 3 / 4 + 2);
+  CHECK_EQ(keyevents[keyevents.size() - 2].id, 1000);
+  CHECK_EQ(keyevents[keyevents.size() - 2].info.state, AFTERTOUCH);
+  CHECK_EQ((uint16_t)keyevents[keyevents.size() - 2].info.velocity, 40000);
+  CHECK_EQ(keyevents.back().info.state, RELEASED);
+}
+
+// The limit taken off mid hold (config or velocity sensitivity switch) still flushes the pending pressure
+void TestFlushWithoutLimit() {
+  AftertouchLimit limit = {.smoothing = 0, .key_interval = 1000};
+  KeyConfig config = {.apply_curve = false, .low_threshold = 1000, .high_threshold = 60000, .activation_offset = 0, .debounce = 0, .aftertouch = &limit};
+  KeyInfo key;
+  fake_millis = 20000;
+  key.update(config, 20000);
+  key.update(config, 20000);
+  key.update(config, 40000);
+  CHECK(key.aftertouchPending);
+  config.aftertouch = nullptr;
+  CHECK(key.update(config, 0));
+  CHECK_EQ(key.state, AFTERTOUCH);
+  CHECK_EQ(limit.flushed, 0u);
+}
+
+int main() {
+  Init();
+  TestReserve();
+  TestReleasesKept();
+  TestPushOut();
+  TestFlushedAftertouchKept();
+  TestFlushWithoutLimit();
+  return TestResult();
+}
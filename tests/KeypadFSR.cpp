@@ -0,0 +1,239 @@
+#include "esp_adc/adc_oneshot.h"
+#include "driver/gpio.h"
+#include "MatrixOS.h"
+
+namespace Device::KeyPad
+{
+  // Pin maps of the real variants, only Init() touches them
+  gpio_num_t keypad_write_pins[8];
+  adc_channel_t keypad_read_adc_channel[8];
+}
+
+#include "devices/MatrixBlock6/Drivers/KeypadFSR.cpp"
+#include "ulp_riscv_adc_ulp_core.h"
+#include "Test.h"
+#include "Fakes.h"
+#include <algorithm>
+#include <array>
+#include <random>
+
+// The FSR scan over a recording of ADC frames, with the ULP program (fakes/FSRKeypadULP.cpp) reading them a pass at a
+// time. Against the scan before the key configs were precomputed, which rebuilt the config of every key on every scan
+// and divided for the velocity, and against a scan of every key, which doesn't trust the ULP's changed bitmap.
+
+using namespace Device::KeyPad;
+
+typedef std::array<uint16_t, 64> Frame;  // 16 bit readings, index x * 8 + y like the ULP's result
+
+extern "C" void scan_keypad(void);
+
+volatile uint16_t (*ulp_readings)[8] = (volatile uint16_t (*)[8])&ulp_result;
+const Frame* adcFrame = nullptr;  // What the ADC reads during the ULP pass
+
+// A synthetic recording at the keypad scan rate. While playing, keys are pressed with their own force, held and let go,
+// every key rests with noise under the press threshold otherwise.
+vector<Frame> Record(uint32_t frames, bool play = true) {
+  std::mt19937 random(7);
+  vector<Frame> recording(frames);
+  struct Press {
+    uint32_t start, length;
+    uint16_t peak;
+  };
+  vector<Press> presses[64];
+  for (uint8_t key = 0; key < 64; key++)
+  {
+    for (uint32_t start = random() % 400; play && start < frames; start += 200 + random() % 600)
+    { presses[key].push_back({start, 30 + (uint32_t)(random() % 500), (uint16_t)(4000 + random() % 50000)}); }
+  }
+  for (uint32_t frame = 0; frame < frames; frame++)
+  {
+    for (uint8_t key = 0; key < 64; key++)
+    {
+      uint32_t reading = random() % 800;
+      for (const Press& press : presses[key])
+      {
+        if (frame < press.start || frame >= press.start + press.length)
+        { continue; }
+        uint32_t t = frame - press.start;
+        uint32_t attack = std::min<uint32_t>(t * 8, 64);       // Ramps up over 8 frames
+        uint32_t decay = std::min<uint32_t>((press.length - t) * 8, 64);
+        reading += press.peak * std::min(attack, decay) / 64 + random() % 1500;
+      }
+      recording[frame][key] = std::min<uint32_t>(reading, UINT16_MAX);
+    }
+  }
+  return recording;
+}
+
+uint16_t ReadADC(gpio_num_t pin, adc_channel_t channel) {
+  uint8_t x = std::find(ulp_keypad_write_pins, ulp_keypad_write_pins + 8, (uint32_t)pin) - ulp_keypad_write_pins;
+  uint8_t y = std::find(ulp_keypad_read_adc_channel, ulp_keypad_read_adc_channel + 8, (uint32_t)channel) - ulp_keypad_read_adc_channel;
+  return x < 8 && y < 8 ? (*adcFrame)[x * 8 + y] >> 4 : 0;
+}
+
+// One ULP pass over the frame: filter the readings into result, flag the keys over their threshold, bump the count
+void Publish(const Frame& frame) {
+  adcFrame = &frame;
+  scan_keypad();
+}
+
+// FSR::Scan() as it was before the key configs were precomputed
+bool LegacyScan() {
+  KeyConfig config = keypad_config;
+  config.curve_scale = 0;
+  for (uint8_t y = 0; y < Device::y_size; y++)
+  {
+    for (uint8_t x = 0; x < Device::x_size; x++)
+    {
+      Fract16 reading = (Fract16)ulp_readings[x][y];
+      int32_t new_low_threshold = (uint16_t)(*FSR::low_thresholds)[x][y] + FSR::lowOffset.Get();
+      int32_t new_high_threshold = (uint16_t)(*FSR::high_thresholds)[x][y] + FSR::highOffset.Get();
+      config.low_threshold = CLAMP(new_low_threshold, 512, UINT16_MAX);
+      config.high_threshold = CLAMP(new_high_threshold, 25600, UINT16_MAX);
+      bool updated = keypadState[x][y].update(config, reading);
+      if (updated)
+      {
+        uint16_t keyID = (1 << 12) + (x << 6) + y;
+        if (NotifyOS(keyID, &keypadState[x][y]))
+        { return true; }
+      }
+    }
+  }
+  return false;
+}
+
+// FSR::Scan() visiting every key, as if the ULP flagged all of them
+bool FullScan() {
+  FSR::pending_keys = UINT64_MAX;
+  return FSR::Scan();
+}
+
+const AftertouchLimit initialAftertouch = keypad_aftertouch;
+
+void Restart() {
+  for (uint8_t x = 0; x < 8; x++)
+  {
+    for (uint8_t y = 0; y < 8; y++)
+    { keypadState[x][y] = KeyInfo(); }
+  }
+  keypad_aftertouch = initialAftertouch;
+  for (uint8_t x = 0; x < 8; x++)
+  {
+    for (uint8_t y = 0; y < 8; y++)
+    { ulp_readings[x][y] = 0; }
+  }
+  FSR::active_keys = 0;
+  FSR::pending_keys = UINT64_MAX;
+  fake_millis = 1000;
+  MatrixOS::KEYPAD::ClearList();
+}
+
+uint32_t FrameTime(uint32_t frame) { return 1000 + frame * 1000 / Device::keypad_scanrate; }
+
+// Events of each key, in order
+typedef vector<KeyEvent> KeyEvents[64];
+
+template <typename ScanFunction>
+void Play(const vector<Frame>& recording, ScanFunction scan, KeyEvents& events) {
+  Restart();
+  KeyEvent taken[KEYEVENT_QUEUE_SIZE];
+  for (uint32_t frame = 0; frame < recording.size(); frame++)
+  {
+    fake_millis = FrameTime(frame);
+    Publish(recording[frame]);
+    CHECK(!scan());
+    uint16_t count = MatrixOS::KEYPAD::GetAll(taken, KEYEVENT_QUEUE_SIZE);
+    for (uint16_t i = 0; i < count; i++)
+    { events[((taken[i].id >> 6) & 7) * 8 + (taken[i].id & 63)].push_back(taken[i]); }
+  }
+}
+
+uint32_t Count(const KeyEvents& events, bool aftertouch) {
+  uint32_t total = 0;
+  for (const vector<KeyEvent>& key : events)
+  { total += std::count_if(key.begin(), key.end(), [&](const KeyEvent& keyevent) { return (keyevent.info.state == AFTERTOUCH) == aftertouch; }); }
+  return total;
+}
+
+// Returns the largest velocity difference. Aftertouch is left out unless exact, a velocity 1 LSB apart can cross the
+// aftertouch threshold on one side and not the other, and the shared rate limit carries that over to other keys.
+int32_t Compare(KeyEvents& actual, KeyEvents& expected, bool exact) {
+  int32_t worst = 0;
+  for (uint8_t key = 0; key < 64; key++)
+  {
+    if (!exact)
+    {
+      for (KeyEvents* events : {&actual, &expected})
+      {
+        vector<KeyEvent>& list = (*events)[key];
+        list.erase(std::remove_if(list.begin(), list.end(), [](const KeyEvent& keyevent) { return keyevent.info.state == AFTERTOUCH; }), list.end());
+      }
+    }
+    CHECK_EQ(actual[key].size(), expected[key].size());
+    for (uint32_t i = 0; i < std::min(actual[key].size(), expected[key].size()); i++)
+    {
+      CHECK_EQ(actual[key][i].info.state, expected[key][i].info.state);
+      worst = std::max(worst, abs((int32_t)(uint16_t)actual[key][i].info.velocity - (uint16_t)expected[key][i].info.velocity));
+    }
+  }
+  return worst;
+}
+
+void TestPrecomputedConfigs(const vector<Frame>& recording) {
+  static KeyEvents legacy, precomputed;
+  Play(recording, LegacyScan, legacy);
+  Play(recording, FSR::Scan, precomputed);
+  uint32_t legacyAftertouch = Count(legacy, true);
+  uint32_t precomputedAftertouch = Count(precomputed, true);
+  uint32_t total = Count(legacy, false);
+
+  int32_t worst = Compare(precomputed, legacy, false);
+  printf("  %d events over %d frames, worst velocity difference %d. Aftertouch %d, was %d\n", total, (int)recording.size(), worst,
+         precomputedAftertouch, legacyAftertouch);
+  CHECK(total > 1000);
+  CHECK(worst <= 1);
+  CHECK(abs((int32_t)precomputedAftertouch - (int32_t)legacyAftertouch) * 100 <= (int32_t)legacyAftertouch);
+}
+
+// Skipping the keys the ULP didn't flag must not change a single event
+void TestChangedBitmap(const vector<Frame>& recording) {
+  static KeyEvents full, skipping;
+  Play(recording, FullScan, full);
+  Play(recording, FSR::Scan, skipping);
+  printf("  %d events with the ULP bitmap, %d scanning every key\n", Count(skipping, false) + Count(skipping, true), Count(full, false) + Count(full, true));
+  CHECK(Count(full, true) > 1000);
+  CHECK_EQ(Compare(skipping, full, true), 0);
+}
+
+void BenchmarkScan(const char* title, const vector<Frame>& recording) {
+  printf("  %s, per scan including the ULP pass\n", title);
+  uint32_t pass = 0;
+  Benchmark("ULP pass alone", recording.size(), [&]() {
+    Publish(recording[pass]);
+    pass = (pass + 1) % recording.size();
+  });
+  for (auto [name, scan] : {std::pair<const char*, bool (*)()>{"Rebuilt config, divide", LegacyScan}, {"Every key", FullScan}, {"ULP bitmap", FSR::Scan}})
+  {
+    Restart();
+    uint32_t frame = 0;
+    Benchmark(name, recording.size(), [&]() {
+      fake_millis = FrameTime(frame);
+      Publish(recording[frame]);
+      scan();
+      MatrixOS::KEYPAD::ClearList();
+      frame = (frame + 1) % recording.size();
+    });
+  }
+}
+
+int main() {
+  fake_ulp_adc = ReadADC;
+  MatrixOS::KEYPAD::Init();
+  FSR::Init();
+  vector<Frame> recording = Record(4800);  // 10 seconds
+  TestPrecomputedConfigs(recording);
+  TestChangedBitmap(recording);
+  BenchmarkScan("Playing", recording);
+  BenchmarkScan("Idle", Record(4800, false));
+  return TestResult();
+}
@@ -0,0 +1,114 @@
+#include "os/system/LED.cpp"
+#include "Test.h"
+#include "Fakes.h"
+
+// Rotating the canvas keeps every pixel at its XY, in the layers, the presented frames and a running crossfade
+
+using namespace MatrixOS::LED;
+
+const EDirection rotations[] = {UP, RIGHT, DOWN, LEFT};
+
+// What a buffer shows at each XY of the grid and the ring around it, row by row
+template <typename Pixel>
+vector<Pixel> Snapshot(const Pixel* buffer) {
+  vector<Pixel> pixels;
+  for (int16_t y = -1; y <= Device::y_size; y++)
+  {
+    for (int16_t x = -1; x <= Device::x_size; x++)
+    {
+      uint16_t index = XY2Index(Point(x, y));
+      if (index != UINT16_MAX)
+      { pixels.push_back(buffer[index]); }
+    }
+  }
+  return pixels;
+}
+
+struct Canvas {
+  vector<vector<Color>> layers;
+  vector<Color> present[3];
+  vector<Color> crossfadeSource;
+  vector<Color16> crossfade;
+};
+
+Canvas Capture() {
+  Canvas canvas;
+  for (Color* layer : frameBuffers)
+  { canvas.layers.push_back(Snapshot(layer)); }
+  for (uint8_t i = 0; i < 3; i++)
+  { canvas.present[i] = Snapshot(presentBuffers[i]); }
+  if (crossfade_active)
+  {
+    canvas.crossfadeSource = Snapshot(crossfade_source_buffer);
+    canvas.crossfade = Snapshot(crossfade_buffer);
+  }
+  return canvas;
+}
+
+// Every pixel gets a color unique to its XY and layer, so any misplaced pixel shows
+void Draw(uint8_t layer) {
+  for (int16_t y = -1; y <= Device::y_size; y++)
+  {
+    for (int16_t x = -1; x <= Device::x_size; x++)
+    { SetColor(Point(x, y), Color(x + 1, y + 1, layer * 16 + 1), layer); }
+  }
+}
+
+void TestTransition(EDirection from, EDirection to) {
+  MatrixOS::UserVar::rotation.value = from;
+  UpdateIndexTable();
+
+  // One layer drawn and presented, then a fade to a new layer started and rendered part way
+  Draw(CurrentLayer());
+  Update();
+  fake_millis += 16;
+  LEDTimerCallback(nullptr);
+  uint8_t top = CreateLayer(500);
+  Draw(top);
+  Update();
+  for (uint8_t frame = 0; frame < 3; frame++)
+  {
+    fake_millis += 16;
+    LEDTimerCallback(nullptr);
+  }
+  CHECK(crossfade_active);
+
+  Canvas before = Capture();
+  RotateCanvas(to);
+  MatrixOS::UserVar::rotation.value = to;
+  Canvas after = Capture();
+
+  CHECK_EQ(after.layers.size(), before.layers.size());
+  for (uint8_t layer = 0; layer < before.layers.size() && layer < after.layers.size(); layer++)
+  { CHECK(after.layers[layer] == before.layers[layer]); }
+  for (uint8_t i = 0; i < 3; i++)
+  { CHECK(after.present[i] == before.present[i]); }
+  CHECK(after.crossfadeSource == before.crossfadeSource);
+  CHECK(after.crossfade == before.crossfade);
+  for (int16_t y = 0; y < Device::y_size; y++)
+  {
+    for (int16_t x = 0; x < Device::x_size; x++)
+    { CHECK(frameBuffers[top][XY2Index(Point(x, y))] == Color(x + 1, y + 1, top * 16 + 1)); }
+  }
+
+  // Finish the fade and drop back to one layer for the next transition
+  fake_millis += 2000;
+  LEDTimerCallback(nullptr);
+  LEDTimerCallback(nullptr);
+  DestroyLayer(500);
+  fake_millis += 2000;
+  LEDTimerCallback(nullptr);
+  LEDTimerCallback(nullptr);
+}
+
+int main() {
+  MatrixOS::UserVar::ui_animation.value = true;
+  Device::LED::Init();
+  Init();
+  for (EDirection from : rotations)
+  {
+    for (EDirection to : rotations)
+    { TestTransition(from, to); }
+  }
+  return TestResult();
+}
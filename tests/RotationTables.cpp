@@ -0,0 +1,46 @@
+#include "os/system/LED.cpp"
+#include "Test.h"
+
+// The LED and keypad lookup tables must give the same answers as rotating and asking the device directly
+
+const EDirection rotations[] = {UP, RIGHT, DOWN, LEFT};
+
+void TestLEDIndexTable(EDirection rotation) {
+  Point dimension(Device::x_size, Device::y_size);
+  // Cover the underglow ring and a margin of points that map to nothing
+  for (int16_t y = -3; y < Device::y_size + 3; y++)
+  {
+    for (int16_t x = -3; x < Device::x_size + 3; x++)
+    { CHECK_EQ(MatrixOS::LED::XY2Index(Point(x, y)), Device::LED::XY2Index(Point(x, y).Rotate(rotation, dimension))); }
+  }
+}
+
+void TestKeyTables(EDirection rotation) {
+  Point dimension(Device::x_size, Device::y_size);
+  for (int16_t y = -3; y < Device::y_size + 3; y++)
+  {
+    for (int16_t x = -3; x < Device::x_size + 3; x++)
+    { CHECK_EQ(MatrixOS::KEYPAD::XY2ID(Point(x, y)), Device::KeyPad::XY2ID(Point(x, y).Rotate(rotation, dimension))); }
+  }
+
+  for (uint32_t keyID = 0; keyID <= UINT16_MAX; keyID++)
+  {
+    Point expected = Device::KeyPad::ID2XY(keyID);
+    if (expected)
+    { expected = expected.Rotate(rotation, dimension, true); }
+    Point actual = MatrixOS::KEYPAD::ID2XY(keyID);
+    CHECK(actual == expected);
+  }
+}
+
+int main() {
+  for (EDirection rotation : rotations)
+  {
+    MatrixOS::UserVar::rotation.value = rotation;
+    MatrixOS::LED::UpdateIndexTable();
+    MatrixOS::KEYPAD::UpdateKeyTable();
+    TestLEDIndexTable(rotation);
+    TestKeyTables(rotation);
+  }
+  return TestResult();
+}
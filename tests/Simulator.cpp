@@ -0,0 +1,49 @@
+#include "MatrixOS.h"
+#include "Test.h"
+
+// The simulator's LED driver stands in for the WS2812 one, check it maps and scales the same way
+
+namespace Device::LED
+{
+  extern vector<uint8_t> output_buffer;
+  extern uint32_t frame_count;
+}
+
+void TestIndexMapping() {
+  for (uint16_t index = 0; index < Device::led_count; index++)
+  {
+    Point xy = Device::LED::Index2XY(index);
+    CHECK(xy);
+    CHECK_EQ(Device::LED::XY2Index(xy), index);
+  }
+  CHECK_EQ(Device::LED::XY2Index(Point(-1, -1)), UINT16_MAX);
+  CHECK_EQ(Device::LED::XY2Index(Point(9, 0)), UINT16_MAX);
+  CHECK(!Device::LED::Index2XY(Device::led_count));
+}
+
+void TestUpdate() {
+  Device::LED::Init();
+  vector<Color> frame(Device::led_count, Color(200, 100, 50));
+  vector<uint8_t> brightness(Device::led_partitions.size(), 128);
+
+  // Only the dirty partitions get written
+  CHECK(Device::LED::Update(frame.data(), brightness, 1));
+  for (uint16_t index = 0; index < Device::led_count; index++)
+  {
+    bool in_first = index < Device::led_partitions[0].start + Device::led_partitions[0].size;
+    CHECK_EQ(Device::LED::output_buffer[index * 3], in_first ? Color::scale8_video(200, 128) : 0);
+    CHECK_EQ(Device::LED::output_buffer[index * 3 + 1], in_first ? Color::scale8_video(100, 128) : 0);
+    CHECK_EQ(Device::LED::output_buffer[index * 3 + 2], in_first ? Color::scale8_video(50, 128) : 0);
+  }
+  CHECK_EQ(Device::LED::frame_count, 1u);
+
+  // Nothing dirty, nothing rendered
+  CHECK(Device::LED::Update(frame.data(), brightness, 0));
+  CHECK_EQ(Device::LED::frame_count, 1u);
+}
+
+int main() {
+  TestIndexMapping();
+  TestUpdate();
+  return TestResult();
+}
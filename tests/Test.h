@@ -0,0 +1,69 @@
+#pragma once
+
+// Minimal host test helpers. A test is a plain program, main returns TestResult() and the makefile runs every test.
+
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+
+inline uint32_t test_checks = 0;
+inline uint32_t test_failures = 0;
+
+#define CHECK(condition) CheckImpl((condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_EQ(actual, expected)                                                                                    \
+  do                                                                                                                  \
+  {                                                                                                                   \
+    auto actual_value = (actual);                                                                                     \
+    auto expected_value = (expected);                                                                                 \
+    if (!CheckImpl(actual_value == expected_value, #actual " == " #expected, __FILE__, __LINE__))                    \
+    { printf("    got %lld, expected %lld\n", (long long)actual_value, (long long)expected_value); }                  \
+  } while (0)
+
+inline bool CheckImpl(bool passed, const char* condition, const char* file, int line) {
+  test_checks++;
+  if (!passed)
+  {
+    // Only print the first few, a broken table can fail thousands of times
+    if (test_failures < 20)
+    { printf("  FAIL %s:%d: %s\n", file, line, condition); }
+    test_failures++;
+  }
+  return passed;
+}
+
+inline int TestResult() {
+  printf("  %u checks, %u failed\n", test_checks, test_failures);
+  return test_failures ? 1 : 0;
+}
+
+// Results of benchmarked code go here so the compiler can't drop the work
+inline volatile uint32_t benchmark_sink;
+
+inline double BenchmarkNow() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+// Time iterations calls of function and print the average in ns per call. The calls are split over a few rounds and
+// the fastest round counts, which keeps a busy host from skewing the result. Benchmarks only report, they never fail a
+// test, host timings say little about the ESP32 beyond the relative cost of two implementations.
+template <typename Function>
+double Benchmark(const char* name, uint32_t iterations, Function function) {
+  const uint8_t rounds = 5;
+  uint32_t per_round = iterations / rounds ? iterations / rounds : 1;
+  double best = 0;
+  function();  // Warm up
+  for (uint8_t round = 0; round < rounds; round++)
+  {
+    double start = BenchmarkNow();
+    for (uint32_t i = 0; i < per_round; i++)
+    { function(); }
+    double per_call = (BenchmarkNow() - start) / per_round;
+    if (round == 0 || per_call < best)
+    { best = per_call; }
+  }
+  printf("  %-40s %10.1f ns\n", name, best);
+  return best;
+}
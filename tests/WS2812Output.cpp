@@ -0,0 +1,120 @@
+#include "MatrixOS.h"
+#include "core/ESP32S3/WS2812/WS2812.cpp"
+#include "FakesESP.h"
+#include "Test.h"
+#include <random>
+
+// The per partition lookup tables against computing every channel on the fly with Color::scale8_video, which is what
+// the output stage did before the tables and what the other device families still do
+
+using namespace WS2812;
+
+uint8_t DirectOutput(uint8_t value, uint8_t brightness, bool gamma) {
+  return Color::scale8_video(gamma ? led_gamma[value] : value, brightness);
+}
+
+std::mt19937 random_engine(1);
+
+vector<Color> RandomFrame() {
+  vector<Color> frame(Device::led_count);
+  for (Color& color : frame)
+  { color = Color(random_engine()); }
+  return frame;
+}
+
+void TestTables() {
+  PartitionLUT lut;
+  for (bool gamma : {false, true})
+  {
+    gamma_correction = gamma;
+    for (uint16_t brightness = 0; brightness < 256; brightness++)
+    {
+      UpdatePartitionLUT(lut, brightness);
+      for (uint16_t value = 0; value < 256; value++)
+      {
+        uint8_t output = DirectOutput(value, brightness, gamma);
+        CHECK_EQ(lut.table[value] & 0xFF, output);
+        // The fraction on top of it never pushes the output past full
+        uint16_t scaled = (gamma ? led_gamma[value] : value) * brightness;
+        CHECK_EQ(lut.table[value] >> 8, output == 255 ? 0 : scaled & 0xFF);
+      }
+    }
+  }
+  gamma_correction = false;
+}
+
+void TestShow() {
+  dithering = false;
+  vector<uint8_t> brightness = {255, 96};
+  for (uint8_t frame_index = 0; frame_index < 20; frame_index++)
+  {
+    vector<Color> frame = RandomFrame();
+    brightness[0] = random_engine();
+    CHECK(Show(frame.data(), brightness));
+    CHECK_EQ(fake_rmt_data.size(), (size_t)Device::led_count * 3);
+    for (uint8_t partition = 0; partition < Device::led_partitions.size(); partition++)
+    {
+      LEDPartition& local_partition = Device::led_partitions[partition];
+      for (uint16_t index = local_partition.start; index < local_partition.start + local_partition.size; index++)
+      {
+        CHECK_EQ(fake_rmt_data[index * 3], DirectOutput(frame[index].G, brightness[partition], false));
+        CHECK_EQ(fake_rmt_data[index * 3 + 1], DirectOutput(frame[index].R, brightness[partition], false));
+        CHECK_EQ(fake_rmt_data[index * 3 + 2], DirectOutput(frame[index].B, brightness[partition], false));
+      }
+    }
+  }
+
+  // Clean partitions keep what they had, the strip is sent up to the last dirty one
+  vector<uint8_t> last(led_data, led_data + Device::led_count * 3);
+  vector<Color> frame = RandomFrame();
+  CHECK(Show(frame.data(), brightness, 1));
+  uint16_t first_end = Device::led_partitions[0].start + Device::led_partitions[0].size;
+  CHECK_EQ(fake_rmt_data.size(), (size_t)first_end * 3);
+  CHECK(std::equal(last.begin() + first_end * 3, last.end(), led_data + first_end * 3));
+
+  // The channel is still sending, nothing gets touched
+  fake_rmt_busy = true;
+  uint32_t transmits = fake_rmt_transmits;
+  CHECK(!Show(frame.data(), brightness));
+  CHECK_EQ(fake_rmt_transmits, transmits);
+  fake_rmt_busy = false;
+}
+
+void BenchmarkFrame() {
+  vector<Color> frame = RandomFrame();
+  vector<uint8_t> brightness = {200, 96};
+  vector<uint8_t> output(Device::led_count * 3);
+
+  printf("  One %d LED frame\n", Device::led_count);
+  Benchmark("per channel scaling (before)", 20000, [&]() {
+    for (uint8_t partition = 0; partition < Device::led_partitions.size(); partition++)
+    {
+      LEDPartition& local_partition = Device::led_partitions[partition];
+      for (uint16_t index = local_partition.start; index < local_partition.start + local_partition.size; index++)
+      {
+        output[index * 3] = DirectOutput(frame[index].G, brightness[partition], gamma_correction);
+        output[index * 3 + 1] = DirectOutput(frame[index].R, brightness[partition], gamma_correction);
+        output[index * 3 + 2] = DirectOutput(frame[index].B, brightness[partition], gamma_correction);
+      }
+    }
+    benchmark_sink = output[0];
+  });
+
+  dithering = false;
+  Benchmark("Show, lookup tables", 20000, [&]() { Show(frame.data(), brightness); });
+  dithering = true;
+  Benchmark("Show, lookup tables and dithering", 20000, [&]() { Show(frame.data(), brightness); });
+
+  // Paid once per brightness change
+  PartitionLUT lut;
+  uint8_t next = 0;
+  Benchmark("table rebuild", 20000, [&]() { UpdatePartitionLUT(lut, ++next); });
+}
+
+int main() {
+  Init(0, Device::led_partitions);
+  TestTables();
+  TestShow();
+  BenchmarkFrame();
+  return TestResult();
+}
@@ -0,0 +1,25 @@
+#include "ulp_riscv_utils.h"
+#include "ulp_riscv_gpio.h"
+#include "ulp_riscv_adc_ulp_core.h"
+
+// The FSR keypad ULP program built for the host. Its variables take the names the ULP build exports them under, and
+// main() is renamed as the tests run scan_keypad() a pass at a time instead.
+
+#define main ulp_main
+#define keypad_write_pins ulp_keypad_write_pins
+#define keypad_read_adc_channel ulp_keypad_read_adc_channel
+#define result ulp_result
+#define threshold ulp_threshold
+#define changed ulp_changed
+#define count ulp_count
+
+extern "C"
+{
+#include "devices/MatrixBlock6/ULP/fsr_keypad.c"
+
+  // The binary KeypadFSR.cpp loads into the ULP
+  extern const uint8_t fake_ulp_bin_start[1] asm("_binary_ulp_fsr_keypad_bin_start");
+  const uint8_t fake_ulp_bin_start[1] = {0};
+  extern const uint8_t fake_ulp_bin_end[1] asm("_binary_ulp_fsr_keypad_bin_end");
+  const uint8_t fake_ulp_bin_end[1] = {0};
+}
@@ -0,0 +1,138 @@
+#include "MatrixOS.h"
+#include "Fakes.h"
+#include <cstdarg>
+#include <cstdlib>
+#include <deque>
+
+// FreeRTOS ---------------------------------------------------------------------------------------------------------
+
+struct FakeQueue {
+  size_t length;
+  size_t item_size;
+  std::deque<vector<uint8_t>> items;
+};
+
+uint32_t fake_millis = 0;
+TickType_t fake_timer_period = 0;
+
+void* pvPortMalloc(size_t size) { return malloc(size); }
+void vPortFree(void* pointer) { free(pointer); }
+size_t xPortGetFreeHeapSize(void) { return 100000; }
+size_t xPortGetMinimumEverFreeHeapSize(void) { return 100000; }
+
+void vTaskSuspendAll(void) {}
+BaseType_t xTaskResumeAll(void) { return pdFALSE; }
+TickType_t xTaskGetTickCount(void) { return fake_millis; }
+TickType_t xTaskGetTickCountFromISR(void) { return fake_millis; }
+void vTaskDelay(TickType_t ticks) { fake_millis += ticks; }
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return (TaskHandle_t)1; }
+BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) { return new FakeQueue{length, item_size, {}}; }
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void* item, TickType_t) {
+  FakeQueue* queue = (FakeQueue*)handle;
+  if (queue->items.size() >= queue->length)
+  { return pdFALSE; }
+  queue->items.emplace_back((const uint8_t*)item, (const uint8_t*)item + queue->item_size);
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t) {
+  FakeQueue* queue = (FakeQueue*)handle;
+  if (queue->items.empty())
+  { return pdFALSE; }
+  memcpy(item, queue->items.front().data(), queue->item_size);
+  queue->items.pop_front();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t handle) {
+  FakeQueue* queue = (FakeQueue*)handle;
+  return queue->length - queue->items.size();
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t handle) { return ((FakeQueue*)handle)->items.size(); }
+
+BaseType_t xQueueReset(QueueHandle_t handle) {
+  ((FakeQueue*)handle)->items.clear();
+  return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) { return (SemaphoreHandle_t)1; }
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return (SemaphoreHandle_t)2; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+
+TimerHandle_t xTimerCreateStatic(const char*, TickType_t period, UBaseType_t, void*, TimerCallbackFunction_t,
+                                 StaticTimer_t*) {
+  fake_timer_period = period;
+  return (TimerHandle_t)1;
+}
+BaseType_t xTimerStart(TimerHandle_t, TickType_t) { return pdPASS; }
+BaseType_t xTimerStop(TimerHandle_t, TickType_t) { return pdPASS; }
+BaseType_t xTimerChangePeriod(TimerHandle_t, TickType_t period, TickType_t) {
+  fake_timer_period = period;
+  return pdPASS;
+}
+
+// Matrix OS -------------------------------------------------------------------------------------------------------
+
+namespace MatrixOS::Logging
+{
+  void LogError(const string &tag, const string &format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("E %s: ", tag.c_str());
+    vprintf(format.c_str(), args);
+    printf("\n");
+    va_end(args);
+  }
+
+  void LogWarning(const string &tag, const string &format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("W %s: ", tag.c_str());
+    vprintf(format.c_str(), args);
+    printf("\n");
+    va_end(args);
+  }
+
+  void LogInfo(const string &, const string &, ...) {}
+  void LogDebug(const string &, const string &, ...) {}
+  void LogVerbose(const string &, const string &, ...) {}
+}
+
+// Nothing is saved, every variable reads back as never saved
+namespace MatrixOS::NVS
+{
+  size_t GetSize(uint32_t) { return -1; }
+  vector<char> GetVariable(uint32_t) { return {}; }
+  int8_t GetVariable(uint32_t, void*, uint16_t) { return 1; }
+  bool SetVariable(uint32_t, void*, uint16_t) { return true; }
+  bool DeleteVariable(uint32_t) { return true; }
+}
+
+namespace MatrixOS::SYS
+{
+  void ErrorHandler(string error) {
+    printf("ErrorHandler: %s\n", error.c_str());
+    abort();
+  }
+
+  uint32_t Millis() { return fake_millis; }
+  uint32_t Micros() { return Device::Micros(); }
+  void DelayMs(uint32_t ms) { fake_millis += ms; }
+}
+
+namespace Device
+{
+  uint32_t Micros() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+  }
+
+  const char* GetEnv(const char*) { return nullptr; }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+// Time as seen by Matrix OS, only moves when a test advances it or something delays
+extern uint32_t fake_millis;
+
+// Period of the last timer created or changed
+extern TickType_t fake_timer_period;
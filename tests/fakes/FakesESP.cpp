@@ -0,0 +1,46 @@
+#include "FakesESP.h"
+#include "esp_random.h"
+#include "driver/rmt_tx.h"
+#include <random>
+
+// ESP-IDF ---------------------------------------------------------------------------------------------------------
+
+std::vector<uint8_t> fake_rmt_data;
+uint32_t fake_rmt_transmits = 0;
+bool fake_rmt_busy = false;
+
+uint32_t esp_random(void) {
+  static std::mt19937 engine(1);  // Seeded, so the tests repeat
+  return engine();
+}
+
+static rmt_encoder_t fake_encoder = {};
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t*, rmt_channel_handle_t* ret_chan) {
+  *ret_chan = (rmt_channel_handle_t)1;
+  return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t) { return ESP_OK; }
+
+esp_err_t rmt_transmit(rmt_channel_handle_t, rmt_encoder_handle_t, const void* payload, size_t payload_bytes,
+                       const rmt_transmit_config_t*) {
+  fake_rmt_data.assign((const uint8_t*)payload, (const uint8_t*)payload + payload_bytes);
+  fake_rmt_transmits++;
+  return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t, int) { return fake_rmt_busy ? ESP_ERR_TIMEOUT : ESP_OK; }
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t*, rmt_encoder_handle_t* ret_encoder) {
+  *ret_encoder = &fake_encoder;
+  return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t*, rmt_encoder_handle_t* ret_encoder) {
+  *ret_encoder = &fake_encoder;
+  return ESP_OK;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t) { return ESP_OK; }
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t) { return ESP_OK; }
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// What the last rmt_transmit() sent, and how many times it got called
+extern std::vector<uint8_t> fake_rmt_data;
+extern uint32_t fake_rmt_transmits;
+
+// rmt_tx_wait_all_done() reports the channel busy while this is set
+extern bool fake_rmt_busy;
@@ -0,0 +1,40 @@
+#pragma once
+
+// Single threaded stand-in for the FreeRTOS kernel, just enough of the API for the host tests. Everything runs on the
+// test's thread, tasks are never started, semaphores always succeed and timers only record their period.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOSConfig.h"
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t StackType_t;
+
+typedef struct { int dummy; } StaticTask_t;
+typedef struct { int dummy; } StaticTimer_t;
+typedef struct { int dummy; } StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+
+typedef void* TaskHandle_t;
+typedef void* TimerHandle_t;
+typedef void* QueueHandle_t;
+typedef void* SemaphoreHandle_t;
+
+typedef void (*TaskFunction_t)(void*);
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffUL
+#define pdMS_TO_TICKS(x) ((TickType_t)(x))
+#define portTICK_PERIOD_MS 1
+#define portYIELD_FROM_ISR(x)
+
+void* pvPortMalloc(size_t size);
+void vPortFree(void* pointer);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
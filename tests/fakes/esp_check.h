@@ -0,0 +1,7 @@
+#pragma once
+
+#include "esp_err.h"
+
+#ifndef __containerof
+#define __containerof(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+#endif
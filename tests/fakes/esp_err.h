@@ -0,0 +1,19 @@
+#pragma once
+
+// ESP-IDF stand-ins for building the ESP32 drivers on the host
+
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_TIMEOUT 0x107
+
+#define ESP_ERROR_CHECK(x) \
+  do                       \
+  {                        \
+    if ((x) != ESP_OK)     \
+    { abort(); }           \
+  } while (0)
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "esp_adc/adc_oneshot.h"
+
+inline void adc_set_hw_calibration_code(adc_unit_t, adc_atten_t) {}
@@ -0,0 +1,3 @@
+#pragma once
+
+inline void esp_sleep_enable_adc_tsens_monitor(bool) {}
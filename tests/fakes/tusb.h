@@ -0,0 +1,6 @@
+#pragma once
+
+// The host tests don't link TinyUSB, only the headers MatrixOS.h pulls in need to resolve
+
+#include <stdint.h>
+#include <stdbool.h>
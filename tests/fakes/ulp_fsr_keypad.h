@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+// The symbols the ULP build exports from devices/MatrixBlock6/ULP/fsr_keypad.c, see FSRKeypadULP.cpp. The generated
+// header declares them as single words, sized here so the host compiler doesn't warn about the casts to arrays.
+extern "C"
+{
+  extern uint32_t ulp_keypad_write_pins[8];
+  extern uint32_t ulp_keypad_read_adc_channel[8];
+  extern uint32_t ulp_result[32];
+  extern uint32_t ulp_threshold[32];
+  extern uint32_t ulp_changed[2];
+  extern uint32_t ulp_count;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+inline void ulp_riscv_halt(void) {}
+inline esp_err_t ulp_riscv_load_binary(const uint8_t*, size_t) { return ESP_OK; }
+inline esp_err_t ulp_riscv_run(void) { return ESP_OK; }
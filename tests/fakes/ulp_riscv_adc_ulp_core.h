@@ -0,0 +1,9 @@
+#pragma once
+
+#include "esp_adc/adc_oneshot.h"
+#include "ulp_riscv_gpio.h"
+
+// 12 bit reading of the channel while the write pin is driven high, set by the test
+inline uint16_t (*fake_ulp_adc)(gpio_num_t pin, adc_channel_t channel) = nullptr;
+
+inline int32_t ulp_riscv_adc_read_channel(adc_unit_t, adc_channel_t channel) { return fake_ulp_adc(fake_ulp_high_pin, channel); }
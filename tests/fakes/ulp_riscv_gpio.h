@@ -0,0 +1,19 @@
+#pragma once
+
+#include "driver/gpio.h"
+
+typedef enum { RTCIO_MODE_INPUT_ONLY, RTCIO_MODE_OUTPUT } rtc_io_mode_t;
+
+// The write pin the ULP drives high right now, GPIO_NUM_NC when none
+inline gpio_num_t fake_ulp_high_pin = GPIO_NUM_NC;
+
+inline void ulp_riscv_gpio_init(gpio_num_t) {}
+inline void ulp_riscv_gpio_output_enable(gpio_num_t) {}
+inline void ulp_riscv_gpio_set_output_mode(gpio_num_t, rtc_io_mode_t) {}
+
+inline void ulp_riscv_gpio_output_level(gpio_num_t pin, uint8_t level) {
+  if (level)
+  { fake_ulp_high_pin = pin; }
+  else if (fake_ulp_high_pin == pin)
+  { fake_ulp_high_pin = GPIO_NUM_NC; }
+}